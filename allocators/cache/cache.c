@@ -58,3 +58,35 @@ HARBOL_EXPORT size_t harbol_cache_remaining(const struct HarbolCache *cache)
 {
 	return (uintptr_t)cache->offset - (uintptr_t)cache->base;
 }
+
+static void *__harbol_cache_allocator_alloc(void *const userdata, const size_t bytes)
+{
+	void *const p = harbol_cache_alloc(userdata, bytes);
+	/* a cache made from a buffer isn't zeroed. */
+	if( p != NULL )
+		memset(p, 0, bytes);
+	return p;
+}
+
+static void *__harbol_cache_allocator_realloc(void *const userdata, void *const ptr, const size_t old_bytes, const size_t bytes)
+{
+	void *const p = __harbol_cache_allocator_alloc(userdata, bytes);
+	if( p != NULL && ptr != NULL )
+		memcpy(p, ptr, (old_bytes < bytes) ? old_bytes : bytes);
+	return p;
+}
+
+static void __harbol_cache_allocator_free(void *const userdata, void *const ptr)
+{
+	(void)userdata; (void)ptr;
+}
+
+HARBOL_EXPORT struct HarbolAllocator harbol_cache_allocator(struct HarbolCache *const cache)
+{
+	return (struct HarbolAllocator){
+		__harbol_cache_allocator_alloc,
+		__harbol_cache_allocator_realloc,
+		__harbol_cache_allocator_free,
+		cache
+	};
+}
@@ -22,6 +22,11 @@ HARBOL_EXPORT NO_NULL bool harbol_cache_clear(struct HarbolCache *cache);
 
 HARBOL_EXPORT NO_NULL void *harbol_cache_alloc(struct HarbolCache *cache, size_t bytes);
 HARBOL_EXPORT NO_NULL size_t harbol_cache_remaining(const struct HarbolCache *cache);
+
+/* wraps the cache so containers can be created with it.
+ * frees are no-ops, everything the containers allocated goes away at once when the cache is cleared.
+ */
+HARBOL_EXPORT NO_NULL struct HarbolAllocator harbol_cache_allocator(struct HarbolCache *cache);
 /********************************************************************/
 
 
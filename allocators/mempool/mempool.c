@@ -358,3 +358,29 @@ HARBOL_EXPORT void harbol_mempool_toggle_auto_defrag(struct HarbolMemPool *const
 {
 	mempool->freelist.auto_defrag ^= true;
 }
+
+static void *__harbol_mempool_allocator_alloc(void *const userdata, const size_t bytes)
+{
+	return harbol_mempool_alloc(userdata, bytes);
+}
+
+static void *__harbol_mempool_allocator_realloc(void *const userdata, void *const ptr, const size_t old_bytes, const size_t bytes)
+{
+	(void)old_bytes;
+	return harbol_mempool_realloc(userdata, ptr, bytes);
+}
+
+static void __harbol_mempool_allocator_free(void *const userdata, void *const ptr)
+{
+	harbol_mempool_free(userdata, ptr);
+}
+
+HARBOL_EXPORT struct HarbolAllocator harbol_mempool_allocator(struct HarbolMemPool *const mempool)
+{
+	return (struct HarbolAllocator){
+		__harbol_mempool_allocator_alloc,
+		__harbol_mempool_allocator_realloc,
+		__harbol_mempool_allocator_free,
+		mempool
+	};
+}
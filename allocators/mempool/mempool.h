@@ -48,6 +48,9 @@ HARBOL_EXPORT NO_NULL size_t harbol_mempool_mem_remaining(const struct HarbolMem
 HARBOL_EXPORT NO_NULL bool harbol_mempool_defrag(struct HarbolMemPool *mempool);
 HARBOL_EXPORT NO_NULL void harbol_mempool_set_max_nodes(struct HarbolMemPool *mempool, size_t nodes);
 HARBOL_EXPORT NO_NULL void harbol_mempool_toggle_auto_defrag(struct HarbolMemPool *mempool);
+
+/* wraps the pool so containers can be created with it, the pool has to outlive them. */
+HARBOL_EXPORT NO_NULL struct HarbolAllocator harbol_mempool_allocator(struct HarbolMemPool *mempool);
 /********************************************************************/
 
 #ifdef __cplusplus
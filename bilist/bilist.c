@@ -7,18 +7,25 @@
 
 HARBOL_EXPORT struct HarbolBiNode *harbol_binode_new(void *const data, const size_t datasize)
 {
-	struct HarbolBiNode *restrict node = harbol_alloc(1, sizeof *node);
+	return harbol_binode_new_with(data, datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolBiNode *harbol_binode_new_with(void *const data, const size_t datasize, const struct HarbolAllocator *const alloc)
+{
+	struct HarbolBiNode *restrict node = harbol_alloc_with(alloc, 1, sizeof *node);
 	if( node != NULL ) {
 		node->next = node->prev = NULL;
-		node->data = harbol_alloc(datasize, sizeof *node->data);
-		if( node->data==NULL )
+		node->data = harbol_alloc_with(alloc, datasize, sizeof *node->data);
+		if( node->data==NULL ) {
+			harbol_free_with(alloc, node);
 			return NULL;
+		}
 		else memcpy(node->data, data, datasize);
 	}
 	return node;
 }
 
-HARBOL_EXPORT bool harbol_binode_free(struct HarbolBiNode **const binoderef, void dtor(void**))
+static NEVER_NULL(2) bool __harbol_binode_destroy(const struct HarbolAllocator *const alloc, struct HarbolBiNode **const binoderef, void dtor(void**))
 {
 	if( *binoderef==NULL )
 		return false;
@@ -26,13 +33,18 @@ HARBOL_EXPORT bool harbol_binode_free(struct HarbolBiNode **const binoderef, voi
 		if( dtor != NULL )
 			dtor((void**)&(*binoderef)->data);
 		
-		harbol_free((*binoderef)->data), (*binoderef)->data=NULL;
-		harbol_binode_free(&(*binoderef)->next, dtor);
-		harbol_free(*binoderef), *binoderef = NULL;
+		harbol_free_with(alloc, (*binoderef)->data), (*binoderef)->data=NULL;
+		__harbol_binode_destroy(alloc, &(*binoderef)->next, dtor);
+		harbol_free_with(alloc, *binoderef), *binoderef = NULL;
 		return true;
 	}
 }
 
+HARBOL_EXPORT bool harbol_binode_free(struct HarbolBiNode **const binoderef, void dtor(void**))
+{
+	return __harbol_binode_destroy(NULL, binoderef, dtor);
+}
+
 HARBOL_EXPORT bool harbol_binode_set(struct HarbolBiNode *const restrict binode, void *const restrict data, const size_t datasize)
 {
 	if( datasize==0 )
@@ -58,12 +70,17 @@ HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new(const size_t datasize)
 
 HARBOL_EXPORT struct HarbolBiList harbol_bilist_create(const size_t datasize)
 {
-	return (struct HarbolBiList){NULL, NULL, 0, datasize};
+	return harbol_bilist_create_with(datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolBiList harbol_bilist_create_with(const size_t datasize, const struct HarbolAllocator *const alloc)
+{
+	return (struct HarbolBiList){NULL, NULL, 0, datasize, alloc};
 }
 
 HARBOL_EXPORT bool harbol_bilist_clear(struct HarbolBiList *const list, void dtor(void**))
 {
-	harbol_binode_free(&list->head, dtor);
+	__harbol_binode_destroy(list->alloc, &list->head, dtor);
 	list->tail = NULL;
 	list->len = 0;
 	return true;
@@ -155,13 +172,13 @@ HARBOL_EXPORT bool harbol_bilist_insert_at_head(struct HarbolBiList *const restr
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolBiNode *node = harbol_binode_new(val, list->datasize);
+		struct HarbolBiNode *node = harbol_binode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_bilist_add_node_at_head(list, node);
 			if( !result )
-				harbol_binode_free(&node, NULL);
+				__harbol_binode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -172,13 +189,13 @@ HARBOL_EXPORT bool harbol_bilist_insert_at_tail(struct HarbolBiList *const restr
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolBiNode *node = harbol_binode_new(val, list->datasize);
+		struct HarbolBiNode *node = harbol_binode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_bilist_add_node_at_tail(list, node);
 			if( !result )
-				harbol_binode_free(&node, NULL);
+				__harbol_binode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -189,13 +206,13 @@ HARBOL_EXPORT bool harbol_bilist_insert_at_index(struct HarbolBiList *const rest
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolBiNode *node = harbol_binode_new(val, list->datasize);
+		struct HarbolBiNode *node = harbol_binode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_bilist_add_node_at_index(list, node, index);
 			if( !result )
-				harbol_binode_free(&node, NULL);
+				__harbol_binode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -286,8 +303,8 @@ HARBOL_EXPORT bool harbol_bilist_index_del(struct HarbolBiList *const list, cons
 		
 		if( dtor != NULL )
 			dtor((void**)&node->data);
-		harbol_free(node->data);
-		harbol_free(node), node=NULL;
+		harbol_free_with(list->alloc, node->data);
+		harbol_free_with(list->alloc, node), node=NULL;
 		list->len--;
 		return true;
 	}
@@ -304,8 +321,8 @@ HARBOL_EXPORT bool harbol_bilist_node_del(struct HarbolBiList *const list, struc
 		
 		if( dtor != NULL )
 			dtor((void**)&node->data);
-		harbol_free(node->data);
-		harbol_free(*noderef), *noderef=NULL;
+		harbol_free_with(list->alloc, node->data);
+		harbol_free_with(list->alloc, *noderef), *noderef=NULL;
 		list->len--;
 		return true;
 	}
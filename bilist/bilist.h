@@ -15,6 +15,7 @@ struct HarbolBiNode {
 };
 
 HARBOL_EXPORT NO_NULL struct HarbolBiNode *harbol_binode_new(void *data, size_t datasize);
+HARBOL_EXPORT NEVER_NULL(1) struct HarbolBiNode *harbol_binode_new_with(void *data, size_t datasize, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_binode_free(struct HarbolBiNode **binoderef, void dtor(void**));
 
 HARBOL_EXPORT NO_NULL bool harbol_binode_set(struct HarbolBiNode *binode, void *data, size_t datasize);
@@ -23,11 +24,13 @@ HARBOL_EXPORT NO_NULL bool harbol_binode_set(struct HarbolBiNode *binode, void *
 struct HarbolBiList {
 	struct HarbolBiNode *head, *tail;
 	size_t len, datasize;
+	const struct HarbolAllocator *alloc; // nodes come from here, so nodes added by hand must too. NULL uses the default allocator.
 };
 
 
 HARBOL_EXPORT struct HarbolBiList *harbol_bilist_new(size_t datasize);
 HARBOL_EXPORT struct HarbolBiList harbol_bilist_create(size_t datasize);
+HARBOL_EXPORT struct HarbolBiList harbol_bilist_create_with(size_t datasize, const struct HarbolAllocator *alloc);
 
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_bilist_clear(struct HarbolBiList *list, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_bilist_free(struct HarbolBiList **listref, void dtor(void**));
@@ -14,8 +14,14 @@ HARBOL_EXPORT struct HarbolByteBuf *harbol_bytebuffer_new(void)
 }
 
 HARBOL_EXPORT struct HarbolByteBuf harbol_bytebuffer_create(void)
+{
+	return harbol_bytebuffer_create_with(NULL);
+}
+
+HARBOL_EXPORT struct HarbolByteBuf harbol_bytebuffer_create_with(const struct HarbolAllocator *const alloc)
 {
 	struct HarbolByteBuf buf = EMPTY_HARBOL_BYTEBUF;
+	buf.alloc = alloc;
 	return buf;
 }
 
@@ -24,8 +30,8 @@ HARBOL_EXPORT bool harbol_bytebuffer_clear(struct HarbolByteBuf *const buf)
 	if( buf->table==NULL )
 		return false;
 	else {
-		harbol_free(buf->table);
-		*buf = (struct HarbolByteBuf)EMPTY_HARBOL_BYTEBUF;
+		harbol_free_with(buf->alloc, buf->table);
+		*buf = harbol_bytebuffer_create_with(buf->alloc);
 		return true;
 	}
 }
@@ -56,11 +62,45 @@ HARBOL_EXPORT uint8_t *harbol_bytebuffer_get_buffer(const struct HarbolByteBuf *
 	return buf->table;
 }
 
+HARBOL_EXPORT size_t harbol_bytebuffer_remaining(const struct HarbolByteBuf *const buf)
+{
+	return buf->len - buf->count;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_reserve(struct HarbolByteBuf *const buf, const size_t bytes)
+{
+	if( bytes <= buf->len )
+		return true;
+	else {
+		/* bytes past 'count' are never read so, unlike vectors, the new tail is left as is. */
+		uint8_t *const table = harbol_realloc_with(buf->alloc, buf->table, buf->len, bytes);
+		if( table==NULL )
+			return false;
+		else {
+			buf->table = table;
+			buf->len = bytes;
+			return true;
+		}
+	}
+}
+
+/* makes sure 'bytes' more can be written, growing geometrically so appends are amortized O(1). */
+static inline NO_NULL bool __harbol_bytebuffer_make_room(struct HarbolByteBuf *const buf, const size_t bytes)
+{
+	const size_t needed = buf->count + bytes;
+	if( needed <= buf->len && buf->table != NULL )
+		return true;
+	else {
+		const size_t len = harbol_grow_len(buf->len, needed);
+		return harbol_bytebuffer_reserve(buf, (len < BYTEBUF_DEFAULT_SIZE) ? BYTEBUF_DEFAULT_SIZE : len);
+	}
+}
+
 
 #ifndef HARBOL_BYTEBUFFER_INSERTION
 #	define HARBOL_BYTEBUFFER_INSERTION \
-	if( buf->count + sizeof val >= buf->len ) \
-		harbol_generic_vector_resizer(buf, buf->count + sizeof val, sizeof *buf->table); \
+	if( !__harbol_bytebuffer_make_room(buf, sizeof val) ) \
+		return false; \
 	memcpy(&buf->table[buf->count], &val, sizeof val); \
 	buf->count += sizeof val; \
 	return true;
@@ -113,9 +153,9 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_cstr(struct HarbolByteBuf *const res
 		return false;
 	else {
 		const size_t cstr_len = strlen(cstr);
-		if( buf->count + cstr_len + 1 >= buf->len )
-			harbol_generic_vector_resizer(buf, buf->count + cstr_len + 1, sizeof *buf->table);
-		strncpy((char *)&buf->table[buf->count], cstr, cstr_len);
+		if( !__harbol_bytebuffer_make_room(buf, cstr_len + 1) )
+			return false;
+		memcpy(&buf->table[buf->count], cstr, cstr_len);
 		buf->count += cstr_len;
 		buf->table[buf->count++] = '\0';
 		return true;
@@ -124,8 +164,8 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_cstr(struct HarbolByteBuf *const res
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_obj(struct HarbolByteBuf *const restrict buf, const void *const obj, const size_t len)
 {
-	if( buf->count + len >= buf->len )
-		harbol_generic_vector_resizer(buf, buf->count + len, sizeof *buf->table);
+	if( !__harbol_bytebuffer_make_room(buf, len) )
+		return false;
 	memcpy(&buf->table[buf->count], obj, len);
 	buf->count += len;
 	return true;
@@ -133,14 +173,76 @@ HARBOL_EXPORT bool harbol_bytebuffer_insert_obj(struct HarbolByteBuf *const rest
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_zeros(struct HarbolByteBuf *const buf, const size_t amount)
 {
-	if( buf->count + amount >= buf->len )
-		harbol_generic_vector_resizer(buf, buf->count + amount, sizeof *buf->table);
+	if( !__harbol_bytebuffer_make_room(buf, amount) )
+		return false;
 	
 	memset(&buf->table[buf->count], 0, amount);
 	buf->count += amount;
 	return true;
 }
 
+/* 'dst' needs 'HARBOL_VARINT_MAX_LEN' bytes of room, returns how many got written. */
+static inline size_t __harbol_varint_write(uint8_t dst[const], uint64_t val)
+{
+	size_t n = 0;
+	while( val >= 0x80 ) {
+		dst[n++] = (uint8_t)val | 0x80;
+		val >>= 7;
+	}
+	dst[n++] = (uint8_t)val;
+	return n;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_varint(struct HarbolByteBuf *const buf, const uint64_t val)
+{
+	if( !__harbol_bytebuffer_make_room(buf, HARBOL_VARINT_MAX_LEN) )
+		return false;
+	
+	buf->count += __harbol_varint_write(&buf->table[buf->count], val);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_zigzag(struct HarbolByteBuf *const buf, const int64_t val)
+{
+	return harbol_bytebuffer_insert_varint(buf, harbol_zigzag_encode(val));
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_varints(struct HarbolByteBuf *const restrict buf, const uint64_t vals[restrict], const size_t count)
+{
+	if( vals==NULL )
+		return false;
+	
+	size_t bytes = 0;
+	for( size_t i=0; i<count; i++ )
+		bytes += harbol_varint_len(vals[i]);
+	
+	if( !__harbol_bytebuffer_make_room(buf, bytes) )
+		return false;
+	
+	uint8_t *const dst = buf->table;
+	for( size_t i=0; i<count; i++ )
+		buf->count += __harbol_varint_write(&dst[buf->count], vals[i]);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytebuffer_insert_zigzags(struct HarbolByteBuf *const restrict buf, const int64_t vals[restrict], const size_t count)
+{
+	if( vals==NULL )
+		return false;
+	
+	size_t bytes = 0;
+	for( size_t i=0; i<count; i++ )
+		bytes += harbol_varint_len(harbol_zigzag_encode(vals[i]));
+	
+	if( !__harbol_bytebuffer_make_room(buf, bytes) )
+		return false;
+	
+	uint8_t *const dst = buf->table;
+	for( size_t i=0; i<count; i++ )
+		buf->count += __harbol_varint_write(&dst[buf->count], harbol_zigzag_encode(vals[i]));
+	return true;
+}
+
 HARBOL_EXPORT bool harbol_bytebuffer_del(struct HarbolByteBuf *const buf, const uindex_t index, const size_t range)
 {
 	// if the entire range is the entire buffer, just clear everything.
@@ -177,19 +279,29 @@ HARBOL_EXPORT bool harbol_bytebuffer_to_file(const struct HarbolByteBuf *const b
 
 HARBOL_EXPORT bool harbol_bytebuffer_insert_from_file(struct HarbolByteBuf *const buf, FILE *const file)
 {
-	fseek(file, 0, SEEK_END);
-	const long int file_size = ftell(file);
-	if( file_size <= 0 )
-		return false;
-	else {
-		rewind(file);
-		if( buf->count + file_size >= buf->len )
-			harbol_generic_vector_resizer(buf, buf->count + file_size, sizeof *buf->table);
+	const ssize_t file_size = get_file_size(file);
+	if( file_size > 0 ) {
+		if( !__harbol_bytebuffer_make_room(buf, file_size) )
+			return false;
 		
 		const size_t bytes_read = fread(&buf->table[buf->count], sizeof *buf->table, file_size, file);
 		buf->count += bytes_read;
 		return bytes_read==(size_t)file_size;
 	}
+	
+	// pipes & other streams that can't be sized get read in chunks until EOF.
+	const size_t old_count = buf->count;
+	for( ;; ) {
+		if( !__harbol_bytebuffer_make_room(buf, BUFSIZ) )
+			return false;
+		
+		const size_t want = buf->len - buf->count;
+		const size_t bytes_read = fread(&buf->table[buf->count], sizeof *buf->table, want, file);
+		buf->count += bytes_read;
+		if( bytes_read < want )
+			break;
+	}
+	return buf->count > old_count && !ferror(file);
 }
 
 HARBOL_EXPORT bool harbol_bytebuffer_append(struct HarbolByteBuf *const bufA, const struct HarbolByteBuf *const bufB)
@@ -197,8 +309,8 @@ HARBOL_EXPORT bool harbol_bytebuffer_append(struct HarbolByteBuf *const bufA, co
 	if( bufB->table==NULL )
 		return false;
 	else {
-		if( bufA->count + bufB->count >= bufA->len )
-			harbol_generic_vector_resizer(bufA, bufA->count + bufB->count, sizeof *bufA->table);
+		if( !__harbol_bytebuffer_make_room(bufA, bufB->count) )
+			return false;
 		
 		memcpy(&bufA->table[bufA->count], bufB->table, bufB->count);
 		bufA->count += bufB->count;
@@ -211,11 +323,191 @@ HARBOL_EXPORT bool harbol_bytebuffer_copy(struct HarbolByteBuf *const bufA, cons
 	if( bufB->table==NULL )
 		return false;
 	else {
-		if( bufB->count != bufA->count )
-			harbol_generic_vector_resizer(bufA, bufB->count, sizeof *bufA->table);
+		if( !harbol_bytebuffer_reserve(bufA, bufB->count) )
+			return false;
 		
 		memcpy(&bufA->table[0], &bufB->table[0], bufB->count);
 		bufA->count = bufB->count;
 		return true;
 	}
 }
+
+
+static inline bool __harbol_host_is_big_endian(void)
+{
+	const uint16_t one = 1;
+	uint8_t first;
+	memcpy(&first, &one, sizeof first);
+	return first==0;
+}
+
+HARBOL_EXPORT struct HarbolByteReader harbol_bytereader_create(const void *const data, const size_t len, const enum HarbolByteOrder order)
+{
+	struct HarbolByteReader reader = EMPTY_HARBOL_BYTEREADER;
+	if( data==NULL )
+		return reader;
+	
+	reader.data = data;
+	reader.len = len;
+	switch( order ) {
+		case HarbolByteOrderNative: reader.swap = false; break;
+		case HarbolByteOrderLittle: reader.swap = __harbol_host_is_big_endian(); break;
+		case HarbolByteOrderBig:    reader.swap = !__harbol_host_is_big_endian(); break;
+	}
+	return reader;
+}
+
+HARBOL_EXPORT struct HarbolByteReader harbol_bytebuffer_reader(const struct HarbolByteBuf *const buf, const enum HarbolByteOrder order)
+{
+	return harbol_bytereader_create(buf->table, buf->count, order);
+}
+
+HARBOL_EXPORT size_t harbol_bytereader_remaining(const struct HarbolByteReader *const reader)
+{
+	return reader->len - reader->pos;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_skip(struct HarbolByteReader *const reader, const size_t bytes)
+{
+	if( !harbol_bytereader_has(reader, bytes) )
+		return false;
+	
+	reader->pos += bytes;
+	return true;
+}
+
+#ifndef HARBOL_BYTEREADER_READ
+#	define HARBOL_BYTEREADER_READ \
+	if( !harbol_bytereader_has(reader, sizeof *val) ) \
+		return false; \
+	harbol_bytereader_read_unchecked(reader, val, sizeof *val); \
+	return true;
+#endif
+
+HARBOL_EXPORT bool harbol_bytereader_read_byte(struct HarbolByteReader *const restrict reader, uint8_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_int16(struct HarbolByteReader *const restrict reader, uint16_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_int32(struct HarbolByteReader *const restrict reader, uint32_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_int64(struct HarbolByteReader *const restrict reader, uint64_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_float32(struct HarbolByteReader *const restrict reader, float32_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_float64(struct HarbolByteReader *const restrict reader, float64_t *const restrict val)
+{
+	HARBOL_BYTEREADER_READ
+}
+
+HARBOL_EXPORT const char *harbol_bytereader_read_cstr(struct HarbolByteReader *const restrict reader, size_t *const restrict len)
+{
+	const size_t left = reader->len - reader->pos;
+	if( left==0 )
+		return NULL;
+	
+	const char *const cstr = (const char *)&reader->data[reader->pos];
+	const char *const end = memchr(cstr, 0, left);
+	if( end==NULL )
+		return NULL;
+	else {
+		const size_t cstr_len = end - cstr;
+		reader->pos += cstr_len + 1;
+		if( len != NULL )
+			*len = cstr_len;
+		return cstr;
+	}
+}
+
+HARBOL_EXPORT const void *harbol_bytereader_read_obj(struct HarbolByteReader *const reader, const size_t len)
+{
+	if( !harbol_bytereader_has(reader, len) )
+		return NULL;
+	else {
+		const void *const obj = &reader->data[reader->pos];
+		reader->pos += len;
+		return obj;
+	}
+}
+
+/* reads at most 'max' bytes, returns how many were used or 0 if the varint is cut off or malformed. */
+static inline size_t __harbol_varint_read(const uint8_t src[const], const size_t max, uint64_t *const restrict val)
+{
+	const size_t limit = ( max < HARBOL_VARINT_MAX_LEN ) ? max : HARBOL_VARINT_MAX_LEN;
+	uint64_t result = 0;
+	for( size_t n=0; n<limit; n++ ) {
+		const uint8_t byte = src[n];
+		/* the last byte only has room for the 64th bit. */
+		if( n==HARBOL_VARINT_MAX_LEN - 1 && byte > 1 )
+			return 0;
+		
+		result |= (uint64_t)(byte & 0x7F) << (7 * n);
+		if( byte < 0x80 ) {
+			*val = result;
+			return n + 1;
+		}
+	}
+	return 0;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_varint(struct HarbolByteReader *const restrict reader, uint64_t *const restrict val)
+{
+	const size_t left = reader->len - reader->pos;
+	const size_t used = ( left==0 ) ? 0 : __harbol_varint_read(&reader->data[reader->pos], left, val);
+	reader->pos += used;
+	return used > 0;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_zigzag(struct HarbolByteReader *const restrict reader, int64_t *const restrict val)
+{
+	uint64_t u = 0;
+	if( !harbol_bytereader_read_varint(reader, &u) )
+		return false;
+	
+	*val = harbol_zigzag_decode(u);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_varints(struct HarbolByteReader *const restrict reader, uint64_t vals[restrict], const size_t count)
+{
+	if( vals==NULL )
+		return false;
+	
+	const size_t start = reader->pos;
+	for( size_t i=0; i<count; i++ ) {
+		if( !harbol_bytereader_read_varint(reader, &vals[i]) ) {
+			reader->pos = start;
+			return false;
+		}
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_bytereader_read_zigzags(struct HarbolByteReader *const restrict reader, int64_t vals[restrict], const size_t count)
+{
+	if( vals==NULL )
+		return false;
+	
+	const size_t start = reader->pos;
+	for( size_t i=0; i<count; i++ ) {
+		if( !harbol_bytereader_read_zigzag(reader, &vals[i]) ) {
+			reader->pos = start;
+			return false;
+		}
+	}
+	return true;
+}
@@ -8,22 +8,34 @@ extern "C" {
 #include "../harbol_common_defines.h"
 #include "../harbol_common_includes.h"
 
+#ifdef COMPILER_MSVC
+#	include <intrin.h>
+#endif
+
+#ifndef BYTEBUF_DEFAULT_SIZE
+#	define BYTEBUF_DEFAULT_SIZE    32
+#endif
+
 struct HarbolByteBuf {
 	uint8_t *table;
 	size_t len, count;
+	const struct HarbolAllocator *alloc; // NULL uses the default allocator.
 };
 
-#define EMPTY_HARBOL_BYTEBUF    { NULL,0,0 }
+#define EMPTY_HARBOL_BYTEBUF    { NULL,0,0,NULL }
 
 
 HARBOL_EXPORT struct HarbolByteBuf *harbol_bytebuffer_new(void);
 HARBOL_EXPORT struct HarbolByteBuf harbol_bytebuffer_create(void);
+HARBOL_EXPORT struct HarbolByteBuf harbol_bytebuffer_create_with(const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_clear(struct HarbolByteBuf *buf);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_free(struct HarbolByteBuf **bufref);
 
 HARBOL_EXPORT NO_NULL size_t harbol_bytebuffer_len(const struct HarbolByteBuf *buf);
 HARBOL_EXPORT NO_NULL size_t harbol_bytebuffer_count(const struct HarbolByteBuf *buf);
 HARBOL_EXPORT NO_NULL uint8_t *harbol_bytebuffer_get_buffer(const struct HarbolByteBuf *buf);
+HARBOL_EXPORT NO_NULL size_t harbol_bytebuffer_remaining(const struct HarbolByteBuf *buf);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_reserve(struct HarbolByteBuf *buf, size_t bytes);
 
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_byte(struct HarbolByteBuf *buf, uint8_t byte);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_int16(struct HarbolByteBuf *buf, uint16_t integer);
@@ -39,6 +51,44 @@ HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytebuffer_insert_cstr(struct HarbolByte
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_obj(struct HarbolByteBuf *buf, const void *obj, size_t len);
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_zeros(struct HarbolByteBuf *buf, size_t amount);
 
+/* LEB128 varints, 7 bits per byte with the high bit set on every byte but the last. */
+#define HARBOL_VARINT_MAX_LEN    10
+
+/* zigzag maps small negative numbers to small unsigned ones so they encode short too. */
+static inline uint64_t harbol_zigzag_encode(const int64_t val)
+{
+	return ((uint64_t)val << 1) ^ -((uint64_t)val >> 63);
+}
+
+static inline int64_t harbol_zigzag_decode(const uint64_t val)
+{
+	return (int64_t)((val >> 1) ^ -(val & 1));
+}
+
+/* bytes 'val' takes as a varint, branchless so batches can size their output in one pass. */
+static inline size_t harbol_varint_len(const uint64_t val)
+{
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+	const size_t bits = 64 - (size_t)__builtin_clzll(val | 1);
+#elif defined(COMPILER_MSVC) && defined(HARBOL64)
+	unsigned long i = 0;
+	_BitScanReverse64(&i, val | 1);
+	const size_t bits = i + 1;
+#else
+	size_t bits = 1;
+	while( bits < 64 && (val >> bits) != 0 )
+		bits++;
+#endif
+	return (bits * 9 + 64) / 64; /* same as ceil(bits / 7) for 1 to 64 bits. */
+}
+
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_varint(struct HarbolByteBuf *buf, uint64_t val);
+HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_zigzag(struct HarbolByteBuf *buf, int64_t val);
+
+/* batches size the whole output first so the buffer grows at most once. */
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytebuffer_insert_varints(struct HarbolByteBuf *buf, const uint64_t vals[], size_t count);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytebuffer_insert_zigzags(struct HarbolByteBuf *buf, const int64_t vals[], size_t count);
+
 #ifdef C11
 #	define harbol_bytebuffer_insert(buf, val)   _Generic((val)+0, \
 													uint8_t : harbol_bytebuffer_insert_byte, \
@@ -58,6 +108,35 @@ HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_insert_zeros(struct HarbolByteBuf *
 												(str, val)
 #endif
 
+/* unchecked writers for hot loops, these never grow the buffer.
+ * reserve (or check 'harbol_bytebuffer_remaining') for the whole batch first.
+ */
+static inline NO_NULL void harbol_bytebuffer_write_unchecked(struct HarbolByteBuf *const restrict buf, const void *const restrict obj, const size_t len)
+{
+	memcpy(&buf->table[buf->count], obj, len);
+	buf->count += len;
+}
+
+static inline NO_NULL void harbol_bytebuffer_write_byte_unchecked(struct HarbolByteBuf *const buf, const uint8_t val)
+{
+	buf->table[buf->count++] = val;
+}
+
+static inline NO_NULL void harbol_bytebuffer_write_int16_unchecked(struct HarbolByteBuf *const buf, const uint16_t val)
+{
+	harbol_bytebuffer_write_unchecked(buf, &val, sizeof val);
+}
+
+static inline NO_NULL void harbol_bytebuffer_write_int32_unchecked(struct HarbolByteBuf *const buf, const uint32_t val)
+{
+	harbol_bytebuffer_write_unchecked(buf, &val, sizeof val);
+}
+
+static inline NO_NULL void harbol_bytebuffer_write_int64_unchecked(struct HarbolByteBuf *const buf, const uint64_t val)
+{
+	harbol_bytebuffer_write_unchecked(buf, &val, sizeof val);
+}
+
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_del(struct HarbolByteBuf *buf, uindex_t index, size_t range);
 
 HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_to_file(const struct HarbolByteBuf *buf, FILE *file);
@@ -68,6 +147,112 @@ HARBOL_EXPORT NO_NULL bool harbol_bytebuffer_copy(struct HarbolByteBuf *bufA, co
 /********************************************************************/
 
 
+/* byte order the reader decodes multi-byte values in, native matches what the 'insert' functions write. */
+enum HarbolByteOrder {
+	HarbolByteOrderNative,
+	HarbolByteOrderLittle,
+	HarbolByteOrderBig,
+};
+
+/* read cursor that decodes bytes in place, it never copies or owns them. */
+struct HarbolByteReader {
+	const uint8_t *data;
+	size_t len, pos;
+	bool swap; // true when the byte order isn't the host's.
+};
+
+#define EMPTY_HARBOL_BYTEREADER    { NULL,0,0,false }
+
+HARBOL_EXPORT struct HarbolByteReader harbol_bytereader_create(const void *data, size_t len, enum HarbolByteOrder order);
+HARBOL_EXPORT NO_NULL struct HarbolByteReader harbol_bytebuffer_reader(const struct HarbolByteBuf *buf, enum HarbolByteOrder order);
+
+HARBOL_EXPORT NO_NULL size_t harbol_bytereader_remaining(const struct HarbolByteReader *reader);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_skip(struct HarbolByteReader *reader, size_t bytes);
+
+/* a failed read leaves the cursor where it was. */
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_byte(struct HarbolByteReader *reader, uint8_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_int16(struct HarbolByteReader *reader, uint16_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_int32(struct HarbolByteReader *reader, uint32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_int64(struct HarbolByteReader *reader, uint64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float32(struct HarbolByteReader *reader, float32_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_float64(struct HarbolByteReader *reader, float64_t *val);
+
+/* both hand back pointers into the data instead of copying, NULL if there isn't enough left.
+ * 'read_cstr' needs the null terminator in bounds and skips past it, 'len' can be NULL.
+ */
+HARBOL_EXPORT NEVER_NULL(1) const char *harbol_bytereader_read_cstr(struct HarbolByteReader *reader, size_t *len);
+HARBOL_EXPORT NO_NULL const void *harbol_bytereader_read_obj(struct HarbolByteReader *reader, size_t len);
+
+/* varints longer than 'HARBOL_VARINT_MAX_LEN' or that overflow 64 bits fail as malformed.
+ * batches either decode all 'count' values or leave the cursor where it was.
+ */
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_varint(struct HarbolByteReader *reader, uint64_t *val);
+HARBOL_EXPORT NO_NULL bool harbol_bytereader_read_zigzag(struct HarbolByteReader *reader, int64_t *val);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytereader_read_varints(struct HarbolByteReader *reader, uint64_t vals[], size_t count);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_bytereader_read_zigzags(struct HarbolByteReader *reader, int64_t vals[], size_t count);
+
+/* unchecked readers for hot loops, check 'harbol_bytereader_has' once for the whole batch first. */
+static inline NO_NULL bool harbol_bytereader_has(const struct HarbolByteReader *const reader, const size_t bytes)
+{
+	return bytes <= reader->len - reader->pos;
+}
+
+static inline NO_NULL void harbol_bytereader_read_unchecked(struct HarbolByteReader *const restrict reader, void *const restrict val, const size_t size)
+{
+	uint8_t *const bytes = val;
+	memcpy(bytes, &reader->data[reader->pos], size);
+	reader->pos += size;
+	if( reader->swap ) {
+		for( size_t i=0; i < size / 2; i++ ) {
+			const uint8_t t = bytes[i];
+			bytes[i] = bytes[size - 1 - i];
+			bytes[size - 1 - i] = t;
+		}
+	}
+}
+
+static inline NO_NULL uint8_t harbol_bytereader_read_byte_unchecked(struct HarbolByteReader *const reader)
+{
+	return reader->data[reader->pos++];
+}
+
+static inline NO_NULL uint16_t harbol_bytereader_read_int16_unchecked(struct HarbolByteReader *const reader)
+{
+	uint16_t val;
+	harbol_bytereader_read_unchecked(reader, &val, sizeof val);
+	return val;
+}
+
+static inline NO_NULL uint32_t harbol_bytereader_read_int32_unchecked(struct HarbolByteReader *const reader)
+{
+	uint32_t val;
+	harbol_bytereader_read_unchecked(reader, &val, sizeof val);
+	return val;
+}
+
+static inline NO_NULL uint64_t harbol_bytereader_read_int64_unchecked(struct HarbolByteReader *const reader)
+{
+	uint64_t val;
+	harbol_bytereader_read_unchecked(reader, &val, sizeof val);
+	return val;
+}
+
+static inline NO_NULL float32_t harbol_bytereader_read_float32_unchecked(struct HarbolByteReader *const reader)
+{
+	float32_t val;
+	harbol_bytereader_read_unchecked(reader, &val, sizeof val);
+	return val;
+}
+
+static inline NO_NULL float64_t harbol_bytereader_read_float64_unchecked(struct HarbolByteReader *const reader)
+{
+	float64_t val;
+	harbol_bytereader_read_unchecked(reader, &val, sizeof val);
+	return val;
+}
+/********************************************************************/
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,216 @@
+#include "segbuf.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+HARBOL_EXPORT struct HarbolSegBuf *harbol_segbuf_new(void)
+{
+	struct HarbolSegBuf *buf = harbol_alloc(1, sizeof *buf);
+	if( buf != NULL )
+		*buf = harbol_segbuf_create();
+	return buf;
+}
+
+HARBOL_EXPORT struct HarbolSegBuf harbol_segbuf_create(void)
+{
+	return harbol_segbuf_create_with(NULL);
+}
+
+HARBOL_EXPORT struct HarbolSegBuf harbol_segbuf_create_with(const struct HarbolAllocator *const alloc)
+{
+	struct HarbolSegBuf buf = EMPTY_HARBOL_SEGBUF;
+	buf.alloc = alloc;
+	return buf;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_clear(struct HarbolSegBuf *const buf)
+{
+	const struct HarbolAllocator *const alloc = buf->alloc;
+	for( struct HarbolByteSeg *seg = buf->head; seg != NULL; ) {
+		struct HarbolByteSeg *const next = seg->next;
+		harbol_free_with(alloc, seg);
+		seg = next;
+	}
+	harbol_free_with(alloc, buf->spare);
+	*buf = harbol_segbuf_create_with(alloc);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_free(struct HarbolSegBuf **const bufref)
+{
+	if( *bufref==NULL )
+		return false;
+	else {
+		const bool res = harbol_segbuf_clear(*bufref);
+		harbol_free(*bufref), *bufref=NULL;
+		return res && *bufref==NULL;
+	}
+}
+
+HARBOL_EXPORT size_t harbol_segbuf_count(const struct HarbolSegBuf *const buf)
+{
+	return buf->count;
+}
+
+/* links an empty segment to the tail, reusing the spare one if there is one. */
+static NO_NULL struct HarbolByteSeg *__harbol_segbuf_add_seg(struct HarbolSegBuf *const buf)
+{
+	struct HarbolByteSeg *seg = buf->spare;
+	if( seg != NULL )
+		buf->spare = NULL;
+	else {
+		seg = harbol_alloc_with(buf->alloc, 1, sizeof *seg + HARBOL_SEGBUF_SEGMENT);
+		if( seg==NULL )
+			return NULL;
+		seg->cap = HARBOL_SEGBUF_SEGMENT;
+	}
+	
+	seg->next = NULL;
+	seg->start = seg->end = 0;
+	if( buf->tail==NULL )
+		buf->head = seg;
+	else buf->tail->next = seg;
+	buf->tail = seg;
+	return seg;
+}
+
+/* unlinks the fully consumed head segment. */
+static NO_NULL void __harbol_segbuf_drop_head(struct HarbolSegBuf *const buf)
+{
+	struct HarbolByteSeg *const seg = buf->head;
+	buf->head = seg->next;
+	if( buf->head==NULL )
+		buf->tail = NULL;
+	
+	if( buf->spare==NULL )
+		buf->spare = seg;
+	else harbol_free_with(buf->alloc, seg);
+}
+
+HARBOL_EXPORT uint8_t *harbol_segbuf_prepare(struct HarbolSegBuf *const restrict buf, size_t *const restrict room)
+{
+	struct HarbolByteSeg *seg = buf->tail;
+	if( seg==NULL || seg->end==seg->cap ) {
+		seg = __harbol_segbuf_add_seg(buf);
+		if( seg==NULL ) {
+			*room = 0;
+			return NULL;
+		}
+	}
+	*room = seg->cap - seg->end;
+	return &seg->data[seg->end];
+}
+
+HARBOL_EXPORT bool harbol_segbuf_commit(struct HarbolSegBuf *const buf, const size_t bytes)
+{
+	struct HarbolByteSeg *const seg = buf->tail;
+	if( seg==NULL || bytes > seg->cap - seg->end )
+		return false;
+	
+	seg->end += bytes;
+	buf->count += bytes;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_insert_obj(struct HarbolSegBuf *const restrict buf, const void *const restrict obj, const size_t len)
+{
+	const uint8_t *src = obj;
+	for( size_t left = len; left > 0; ) {
+		size_t room = 0;
+		uint8_t *const dst = harbol_segbuf_prepare(buf, &room);
+		if( dst==NULL )
+			return false;
+		
+		const size_t amount = ( left < room ) ? left : room;
+		memcpy(dst, src, amount);
+		harbol_segbuf_commit(buf, amount);
+		src += amount, left -= amount;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_insert_byte(struct HarbolSegBuf *const buf, const uint8_t byte)
+{
+	size_t room = 0;
+	uint8_t *const dst = harbol_segbuf_prepare(buf, &room);
+	if( dst==NULL )
+		return false;
+	
+	*dst = byte;
+	return harbol_segbuf_commit(buf, 1);
+}
+
+HARBOL_EXPORT bool harbol_segbuf_insert_bytebuffer(struct HarbolSegBuf *const restrict buf, const struct HarbolByteBuf *const restrict bytebuf)
+{
+	return( bytebuf->count==0 ) ? true : harbol_segbuf_insert_obj(buf, bytebuf->table, bytebuf->count);
+}
+
+HARBOL_EXPORT const uint8_t *harbol_segbuf_front(const struct HarbolSegBuf *const restrict buf, size_t *const restrict len)
+{
+	const struct HarbolByteSeg *const seg = buf->head;
+	if( buf->count==0 ) {
+		*len = 0;
+		return NULL;
+	}
+	*len = seg->end - seg->start;
+	return &seg->data[seg->start];
+}
+
+HARBOL_EXPORT bool harbol_segbuf_peek(const struct HarbolSegBuf *const restrict buf, void *const restrict out, const size_t len)
+{
+	if( len > buf->count )
+		return false;
+	
+	uint8_t *dst = out;
+	size_t left = len;
+	for( const struct HarbolByteSeg *seg = buf->head; left > 0; seg = seg->next ) {
+		const size_t avail = seg->end - seg->start;
+		const size_t amount = ( left < avail ) ? left : avail;
+		memcpy(dst, &seg->data[seg->start], amount);
+		dst += amount, left -= amount;
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_consume(struct HarbolSegBuf *const buf, size_t bytes)
+{
+	if( bytes > buf->count )
+		return false;
+	
+	buf->count -= bytes;
+	while( bytes > 0 ) {
+		struct HarbolByteSeg *const seg = buf->head;
+		const size_t avail = seg->end - seg->start;
+		if( bytes < avail ) {
+			seg->start += bytes;
+			break;
+		}
+		bytes -= avail;
+		/* an emptied tail stays around to write into. */
+		if( seg==buf->tail )
+			seg->start = seg->end = 0;
+		else __harbol_segbuf_drop_head(buf);
+	}
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_segbuf_read(struct HarbolSegBuf *const restrict buf, void *const restrict out, const size_t len)
+{
+	return harbol_segbuf_peek(buf, out, len) && harbol_segbuf_consume(buf, len);
+}
+
+HARBOL_EXPORT size_t harbol_segbuf_get_iovecs(const struct HarbolSegBuf *const restrict buf, struct iovec iov[restrict], const size_t max)
+{
+	size_t filled = 0;
+	for( const struct HarbolByteSeg *seg = buf->head; seg != NULL && filled < max; seg = seg->next ) {
+		if( seg->end==seg->start )
+			continue;
+		
+		iov[filled].iov_base = (void *)&seg->data[seg->start];
+		iov[filled].iov_len = seg->end - seg->start;
+		filled++;
+	}
+	return filled;
+}
@@ -0,0 +1,80 @@
+#ifndef HARBOL_SEGBUF_INCLUDED
+#	define HARBOL_SEGBUF_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "bytebuffer.h"
+
+#ifdef OS_WINDOWS
+/* same layout as the posix one, windows sockets take a WSABUF made from these. */
+struct iovec {
+	void *iov_base;
+	size_t iov_len;
+};
+#else
+#	include <sys/uio.h>
+#endif
+
+#ifndef HARBOL_SEGBUF_SEGMENT
+#	define HARBOL_SEGBUF_SEGMENT    65536
+#endif
+
+
+/* live bytes are [start, end), consuming moves 'start' and appending moves 'end'. */
+struct HarbolByteSeg {
+	struct HarbolByteSeg *next;
+	size_t start, end, cap;
+	uint8_t data[];
+};
+
+/* byte queue made of fixed size segments, bytes never move once written.
+ * appends fill the tail segment and consuming from the front just drops or recycles segments,
+ * so nothing is memmoved or reallocated no matter how big the buffer gets.
+ */
+struct HarbolSegBuf {
+	struct HarbolByteSeg *head, *tail;
+	struct HarbolByteSeg *spare; // last fully consumed segment, kept so a steady stream doesn't hit the allocator.
+	size_t count;
+	const struct HarbolAllocator *alloc;
+};
+
+#define EMPTY_HARBOL_SEGBUF    { NULL,NULL,NULL,0,NULL }
+
+HARBOL_EXPORT struct HarbolSegBuf *harbol_segbuf_new(void);
+HARBOL_EXPORT struct HarbolSegBuf harbol_segbuf_create(void);
+HARBOL_EXPORT struct HarbolSegBuf harbol_segbuf_create_with(const struct HarbolAllocator *alloc);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_clear(struct HarbolSegBuf *buf);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_free(struct HarbolSegBuf **bufref);
+
+HARBOL_EXPORT NO_NULL size_t harbol_segbuf_count(const struct HarbolSegBuf *buf);
+
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_insert_byte(struct HarbolSegBuf *buf, uint8_t byte);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_insert_obj(struct HarbolSegBuf *buf, const void *obj, size_t len);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_insert_bytebuffer(struct HarbolSegBuf *buf, const struct HarbolByteBuf *bytebuf);
+
+/* for filling the buffer straight from a read/recv call.
+ * 'prepare' gives the tail's free space (at least 1 byte) and 'commit' adds however much of it got written.
+ */
+HARBOL_EXPORT NO_NULL uint8_t *harbol_segbuf_prepare(struct HarbolSegBuf *buf, size_t *room);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_commit(struct HarbolSegBuf *buf, size_t bytes);
+
+/* contiguous bytes at the front, NULL when empty. */
+HARBOL_EXPORT NO_NULL const uint8_t *harbol_segbuf_front(const struct HarbolSegBuf *buf, size_t *len);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_peek(const struct HarbolSegBuf *buf, void *out, size_t len);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_read(struct HarbolSegBuf *buf, void *out, size_t len);
+HARBOL_EXPORT NO_NULL bool harbol_segbuf_consume(struct HarbolSegBuf *buf, size_t bytes);
+
+/* fills up to 'max' iovecs from the front for 'writev', returns how many got filled.
+ * consume however many bytes 'writev' took afterwards.
+ */
+HARBOL_EXPORT NO_NULL size_t harbol_segbuf_get_iovecs(const struct HarbolSegBuf *buf, struct iovec iov[], size_t max);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_SEGBUF_INCLUDED */
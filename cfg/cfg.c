@@ -1,4 +1,6 @@
 #include "cfg.h"
+#include "../stringobj/strbuilder.h"
+#include "../fileview/fileview.h"
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
@@ -76,7 +78,7 @@ static bool NO_NULL _lex_number(const char **restrict strref, struct HarbolStrin
 		} else {
 			*strref = end;
 			*typeref = (is_float) ? HarbolCfgType_Float : HarbolCfgType_Int;
-			return str->len > 0;
+			return harbol_string_len(str) > 0;
 		}
 	}
 }
@@ -99,16 +101,16 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		return false;
 	}
 	
-	struct HarbolString keystr = {NULL, 0};
+	struct HarbolString keystr = EMPTY_HARBOL_STRING;
 	const bool strresult = lex_c_style_str(*cfgcoderef, cfgcoderef, &keystr);
 	if( !strresult ) {
 		if( _g_cfg_err.count < HARBOL_CFG_ERR_STK_SIZE )
-			harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: invalid string key '%s'. Line: %zu\n", keystr.cstr, _g_cfg_err.curr_line);
+			harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: invalid string key '%s'. Line: %zu\n", harbol_string_cstr(&keystr), _g_cfg_err.curr_line);
 		harbol_string_clear(&keystr);
 		return false;
-	} else if( harbol_linkmap_has_key(map, keystr.cstr) ) {
+	} else if( harbol_linkmap_has_key(map, harbol_string_cstr(&keystr)) ) {
 		if( _g_cfg_err.count < HARBOL_CFG_ERR_STK_SIZE )
-			harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: duplicate string key '%s'. Line: %zu\n", keystr.cstr, _g_cfg_err.curr_line);
+			harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: duplicate string key '%s'. Line: %zu\n", harbol_string_cstr(&keystr), _g_cfg_err.curr_line);
 		harbol_string_clear(&keystr);
 		return false;
 	}
@@ -122,7 +124,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		struct HarbolLinkMap *subsection = harbol_linkmap_new(sizeof(struct HarbolVariant));
 		res = harbol_cfg_parse_section(subsection, cfgcoderef);
 		struct HarbolVariant var = harbol_variant_create(&subsection, sizeof(struct HarbolLinkMap *), HarbolCfgType_Linkmap);
-		const bool inserted = harbol_linkmap_insert(map, keystr.cstr, &var);
+		const bool inserted = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 		if( !inserted )
 			harbol_variant_clear(&var, (void(*)(void**))&harbol_cfg_free);
 		_g_iota.local = old;
@@ -136,11 +138,11 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 					harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: unable to allocate string value. Line: %zu\n", _g_cfg_err.curr_line);
 			} else {
 				if( _g_cfg_err.count < HARBOL_CFG_ERR_STK_SIZE )
-					harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: invalid string value '%s'. Line: %zu\n", str->cstr, _g_cfg_err.curr_line);
+					harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: invalid string value '%s'. Line: %zu\n", harbol_string_cstr(str), _g_cfg_err.curr_line);
 			} return false;
 		}
 		struct HarbolVariant var = harbol_variant_create(&str, sizeof(struct HarbolString *), HarbolCfgType_String);
-		harbol_linkmap_insert(map, keystr.cstr, &var);
+		harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='c' || **cfgcoderef=='v' ) {
 		// color or vector value!
 		const char valtype = *(*cfgcoderef)++;
@@ -162,22 +164,22 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		
 		size_t iterations = 0;
 		while( **cfgcoderef != 0 && **cfgcoderef != ']' ) {
-			struct HarbolString numstr = {NULL, 0};
+			struct HarbolString numstr = EMPTY_HARBOL_STRING;
 			enum HarbolCfgType type = HarbolCfgType_Null;
 			const bool result = _lex_number(cfgcoderef, &numstr, &type);
 			if( iterations<4 ) {
 				if( valtype=='c' ) {
 					switch( iterations ) {
-						case 0: matrix_value.color.bytes.r = (uint8_t)strtoul(numstr.cstr, NULL, 0); break;
-						case 1: matrix_value.color.bytes.g = (uint8_t)strtoul(numstr.cstr, NULL, 0); break;
-						case 2: matrix_value.color.bytes.b = (uint8_t)strtoul(numstr.cstr, NULL, 0); break;
-						case 3: matrix_value.color.bytes.a = (uint8_t)strtoul(numstr.cstr, NULL, 0); break;
+						case 0: matrix_value.color.bytes.r = (uint8_t)strtoul(harbol_string_cstr(&numstr), NULL, 0); break;
+						case 1: matrix_value.color.bytes.g = (uint8_t)strtoul(harbol_string_cstr(&numstr), NULL, 0); break;
+						case 2: matrix_value.color.bytes.b = (uint8_t)strtoul(harbol_string_cstr(&numstr), NULL, 0); break;
+						case 3: matrix_value.color.bytes.a = (uint8_t)strtoul(harbol_string_cstr(&numstr), NULL, 0); break;
 					}
 					iterations++;
 				} else {
 					/// gotta use `harbol_string_scan` for possible hex floats.
 					float32_t f = 0;
-					const bool is_hex = !strncmp(numstr.cstr, "0x", 2) || !strncmp(numstr.cstr, "0X", 2);
+					const bool is_hex = !strncmp(harbol_string_cstr(&numstr), "0x", 2) || !strncmp(harbol_string_cstr(&numstr), "0X", 2);
 					switch( iterations ) {
 						case 0:
 							harbol_string_scan(&numstr, is_hex ? "%" SCNxf32 "" : "%" SCNf32 "", &f);
@@ -217,7 +219,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		
 		struct HarbolVariant var = (valtype=='c') ?
 			harbol_variant_create(&matrix_value.color, sizeof(union HarbolColor), HarbolCfgType_Color) : harbol_variant_create(&matrix_value.vec4d, sizeof(struct HarbolVec4D), HarbolCfgType_Vec4D);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='t' ) {
 		// true bool value.
 		if( strncmp("true", *cfgcoderef, sizeof("true")-1) ) {
@@ -228,7 +230,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		}
 		*cfgcoderef += sizeof("true") - 1;
 		struct HarbolVariant var = harbol_variant_create(&(bool){true}, sizeof(bool), HarbolCfgType_Bool);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='f' ) {
 		// false bool value
 		if( strncmp("false", *cfgcoderef, sizeof("false")-1) ) {
@@ -239,7 +241,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		}
 		*cfgcoderef += sizeof("false") - 1;
 		struct HarbolVariant var = harbol_variant_create(&(bool){false}, sizeof(bool), HarbolCfgType_Bool);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='n' ) {
 		// null value.
 		if( strncmp("null", *cfgcoderef, sizeof("null")-1) ) {
@@ -250,7 +252,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		}
 		*cfgcoderef += sizeof("null") - 1;
 		struct HarbolVariant var = harbol_variant_create(&(char){0}, sizeof(char), HarbolCfgType_Null);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='I' ) {
 		// global iota value.
 		if( strncmp("Iota", *cfgcoderef, sizeof("Iota")-1) ) {
@@ -261,7 +263,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		}
 		*cfgcoderef += sizeof("Iota") - 1;
 		struct HarbolVariant var = harbol_variant_create(&(intmax_t){_g_iota.global++}, sizeof(intmax_t), HarbolCfgType_Int);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( **cfgcoderef=='i' ) {
 		// local iota value.
 		if( strncmp("iota", *cfgcoderef, sizeof("iota")-1) ) {
@@ -272,7 +274,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 		}
 		*cfgcoderef += sizeof("iota") - 1;
 		struct HarbolVariant var = harbol_variant_create(&(intmax_t){(*_g_iota.local)++}, sizeof(intmax_t), HarbolCfgType_Int);
-		res = harbol_linkmap_insert(map, keystr.cstr, &var);
+		res = harbol_linkmap_insert(map, harbol_string_cstr(&keystr), &var);
 	} else if( is_decimal(**cfgcoderef) || **cfgcoderef=='.' || **cfgcoderef=='-' || **cfgcoderef=='+' ) {
 		// numeric value.
 		res = harbol_cfg_parse_number(map, &keystr, cfgcoderef);
@@ -293,7 +295,7 @@ static bool harbol_cfg_parse_key_val(struct HarbolLinkMap *const restrict map, c
 
 static bool harbol_cfg_parse_number(struct HarbolLinkMap *const restrict map, const struct HarbolString *const restrict key, const char **cfgcoderef)
 {
-	struct HarbolString numstr = {NULL, 0};
+	struct HarbolString numstr = EMPTY_HARBOL_STRING;
 	enum HarbolCfgType type = HarbolCfgType_Null;
 	const bool result = _lex_number(cfgcoderef, &numstr, &type);
 	if( !result ) {
@@ -308,10 +310,10 @@ static bool harbol_cfg_parse_number(struct HarbolLinkMap *const restrict map, co
 			harbol_string_scan(&numstr, "%" SCNxfMAX "", &f);
 			var = harbol_variant_create(&f, sizeof(floatmax_t), type);
 		} else {
-			var = harbol_variant_create(&(intmax_t){strtoll(numstr.cstr, NULL, 0)}, sizeof(intmax_t), HarbolCfgType_Int);
+			var = harbol_variant_create(&(intmax_t){strtoll(harbol_string_cstr(&numstr), NULL, 0)}, sizeof(intmax_t), HarbolCfgType_Int);
 		}
 		harbol_string_clear(&numstr);
-		return harbol_linkmap_insert(map, key->cstr, &var);
+		return harbol_linkmap_insert(map, harbol_string_cstr(key), &var);
 	}
 }
 
@@ -349,17 +351,18 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_file(const char filename[re
 			harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: unable to find file '%s'.\n", filename);
 		return NULL;
 	} else {
-		struct HarbolString cfg = {NULL, 0};
-		const bool read_result = harbol_string_read_file(&cfg, cfgfile);
+		// parses straight out of the mapped file, no copy into a string.
+		struct HarbolFileView view = harbol_fileview_create_from_file(cfgfile);
 		fclose(cfgfile);
 		
-		if( !read_result ) {
+		if( view.data==NULL || view.len==0 ) {
 			if( _g_cfg_err.count < HARBOL_CFG_ERR_STK_SIZE )
 				harbol_string_format(&_g_cfg_err.errs[_g_cfg_err.count++], "Harbol Config Parser :: failed to read file '%s' into a string.\n", filename);
+			harbol_fileview_clear(&view);
 			return NULL;
 		} else {
-			struct HarbolLinkMap *const restrict objs = harbol_cfg_parse_cstr(cfg.cstr);
-			harbol_string_clear(&cfg);
+			struct HarbolLinkMap *const restrict objs = harbol_cfg_parse_cstr(view.data);
+			harbol_fileview_clear(&view);
 			return objs;
 		}
 	}
@@ -379,7 +382,7 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_parse_cstr(const char cfgcode[])
 		while( harbol_cfg_parse_key_val(objs, &iter) );
 		if( _g_cfg_err.count > 0 ) {
 			for( uindex_t i=0; i<_g_cfg_err.count; i++ ) {
-				fputs(_g_cfg_err.errs[i].cstr, stderr);
+				fputs(harbol_string_cstr(&_g_cfg_err.errs[i]), stderr);
 				harbol_string_clear(&_g_cfg_err.errs[i]);
 			}
 			_g_cfg_err.count = 0;
@@ -423,65 +426,76 @@ HARBOL_EXPORT bool harbol_cfg_free(struct HarbolLinkMap **mapref)
 	else {
 		struct HarbolKeyVal **const end = harbol_linkmap_get_iter_end_count(*mapref);
 		for( struct HarbolKeyVal **iter = harbol_linkmap_get_iter(*mapref); iter && iter<end; iter++ )
-			__harbol_cfgkey_del((struct HarbolVariant *)(*iter)->data);
+			if( *iter != NULL )
+				__harbol_cfgkey_del((struct HarbolVariant *)(*iter)->data);
 		
 		harbol_linkmap_free(mapref, NULL);
 		return *mapref==NULL;
 	}
 }
 
-static inline NO_NULL void __concat_tabs(struct HarbolString *const str, const size_t tabs)
+static inline NO_NULL void __concat_tabs(struct HarbolStrBuilder *const builder, const size_t tabs)
 {
 	for( uindex_t i=0; i<tabs; i++ )
-		harbol_string_add_cstr(str, "\t");
+		harbol_strbuilder_add_char(builder, '\t');
 }
 
-HARBOL_EXPORT struct HarbolString harbol_cfg_to_str(const struct HarbolLinkMap *const map)
+/* sections are written straight into the one builder so nested output doesn't get recopied at every level. */
+static NO_NULL void __harbol_cfg_to_builder(const struct HarbolLinkMap *const map, struct HarbolStrBuilder *const builder, const size_t tabs)
 {
-	static size_t tabs = 0;
-	struct HarbolString str = harbol_string_create("");
 	for( uindex_t i=0; i<map->vec.count; i++ ) {
 		struct HarbolKeyVal **const iter = harbol_vector_get(&map->vec, i);
+		if( *iter==NULL )
+			continue;
+		
 		const struct HarbolVariant *var = (const struct HarbolVariant *)(*iter)->data;
 		
 		const union ConfigVal cv = { var->data };
 		// using double pointer iterators as we need the key.
-		__concat_tabs(&str, tabs);
-		harbol_string_add_format(&str, "\"%s\": ", (*iter)->key.cstr);
+		__concat_tabs(builder, tabs);
+		harbol_strbuilder_add_char(builder, '"');
+		harbol_strbuilder_add_str(builder, &(*iter)->key);
+		harbol_strbuilder_add_cstr(builder, "\": ");
 		switch( var->tag ) {
 			case HarbolCfgType_Null:
-				harbol_string_add_cstr(&str, "null\n");
+				harbol_strbuilder_add_cstr(builder, "null\n");
 				break;
-			case HarbolCfgType_Linkmap: {
-				harbol_string_add_cstr(&str, "{\n");
-				tabs++;
-				struct HarbolString inner_str = harbol_cfg_to_str(*cv.section);
-				harbol_string_add_format(&str, "%s", inner_str.cstr);
-				__concat_tabs(&str, --tabs);
-				harbol_string_add_cstr(&str, "}\n");
-				harbol_string_clear(&inner_str);
+			case HarbolCfgType_Linkmap:
+				harbol_strbuilder_add_cstr(builder, "{\n");
+				__harbol_cfg_to_builder(*cv.section, builder, tabs + 1);
+				__concat_tabs(builder, tabs);
+				harbol_strbuilder_add_cstr(builder, "}\n");
 				break;
-			}
 			case HarbolCfgType_String:
-				harbol_string_add_format(&str, "\"%s\"\n", (*cv.str)->cstr);
+				harbol_strbuilder_add_char(builder, '"');
+				harbol_strbuilder_add_str(builder, *cv.str);
+				harbol_strbuilder_add_cstr(builder, "\"\n");
 				break;
 			case HarbolCfgType_Float:
-				harbol_string_add_format(&str, "%" PRIfMAX "\n", *cv.f);
+				harbol_strbuilder_add_format(builder, "%" PRIfMAX "\n", *cv.f);
 				break;
 			case HarbolCfgType_Int:
-				harbol_string_add_format(&str, "%" PRIiMAX "\n", *cv.i);
+				harbol_strbuilder_add_format(builder, "%" PRIiMAX "\n", *cv.i);
 				break;
 			case HarbolCfgType_Bool:
-				harbol_string_add_cstr(&str, *cv.b ? "true\n" : "false\n");
+				harbol_strbuilder_add_cstr(builder, *cv.b ? "true\n" : "false\n");
 				break;
 			case HarbolCfgType_Color:
-				harbol_string_add_format(&str, "c[ %u, %u, %u, %u ]\n", cv.c->bytes.r, cv.c->bytes.g, cv.c->bytes.b, cv.c->bytes.a);
+				harbol_strbuilder_add_format(builder, "c[ %u, %u, %u, %u ]\n", cv.c->bytes.r, cv.c->bytes.g, cv.c->bytes.b, cv.c->bytes.a);
 				break;
 			case HarbolCfgType_Vec4D:
-				harbol_string_add_format(&str, "v[ %" PRIf32 ", %" PRIf32 ", %" PRIf32 ", %" PRIf32 " ]\n", cv.v->x, cv.v->y, cv.v->z, cv.v->w);
+				harbol_strbuilder_add_format(builder, "v[ %" PRIf32 ", %" PRIf32 ", %" PRIf32 ", %" PRIf32 " ]\n", cv.v->x, cv.v->y, cv.v->z, cv.v->w);
 				break;
 		}
 	}
+}
+	
+HARBOL_EXPORT struct HarbolString harbol_cfg_to_str(const struct HarbolLinkMap *const map)
+{
+	struct HarbolStrBuilder builder = harbol_strbuilder_create();
+	__harbol_cfg_to_builder(map, &builder, 0);
+	struct HarbolString str = harbol_strbuilder_to_str(&builder);
+	harbol_strbuilder_clear(&builder);
 	return str;
 }
 
@@ -515,7 +529,7 @@ static NO_NULL bool harbol_cfg_parse_target_path(const char key[static 1], struc
 		}
 		else harbol_string_add_char(str, *iter++);
 	}
-	return str->len > 0;
+	return harbol_string_len(str) > 0;
 }
 
 static NO_NULL struct HarbolVariant *__get_var(struct HarbolLinkMap *const restrict cfgmap, const char key[static 1])
@@ -532,28 +546,39 @@ static NO_NULL struct HarbolVariant *__get_var(struct HarbolLinkMap *const restr
 		// parse the target key first.
 		const char *iter = key;
 		struct HarbolString
-			sectionstr = {NULL, 0},
-			targetstr = {NULL, 0}
+			sectionstr = EMPTY_HARBOL_STRING,
+			targetstr = EMPTY_HARBOL_STRING
 		;
 		harbol_cfg_parse_target_path(key, &targetstr);
 		struct HarbolLinkMap *restrict itermap = cfgmap;
 		struct HarbolVariant *restrict var = NULL;
 		
 		while( itermap != NULL ) {
+			/* sections are looked up straight out of the keypath, only escaped dots need a copy. */
+			struct HarbolStrView section = { iter, 0 };
+			bool escaped = false;
 			harbol_string_clear(&sectionstr);
 			// Patch: allow keys to use dot without interfering with dot path.
 			while( *iter != 0 ) {
 				if( (*iter=='/' || *iter=='\\') && iter[1] && iter[1]=='.' ) {
+					if( !escaped )
+						harbol_string_copy_view(&sectionstr, (struct HarbolStrView){ section.ptr, iter - section.ptr });
+					escaped = true;
 					iter++;
 					harbol_string_add_char(&sectionstr, *iter++);
 				} else if( *iter=='.' ) {
-					iter++;
 					break;
+				} else {
+					if( escaped )
+						harbol_string_add_char(&sectionstr, *iter);
+					iter++;
 				}
-				else harbol_string_add_char(&sectionstr, *iter++);
 			}
-			var = harbol_linkmap_key_get(itermap, sectionstr.cstr);
-			if( var==NULL || !harbol_string_cmpstr(&sectionstr, &targetstr) )
+			section = escaped ? harbol_string_view(&sectionstr) : (struct HarbolStrView){ section.ptr, iter - section.ptr };
+			if( *iter=='.' )
+				iter++;
+			var = harbol_linkmap_key_get_view(itermap, section);
+			if( var==NULL || !harbol_string_cmpview(&targetstr, section) )
 				break;
 			else if( var->tag==HarbolCfgType_Linkmap )
 				itermap = *(struct HarbolLinkMap **)var->data;
@@ -573,7 +598,7 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_cfg_get_section(struct HarbolLinkMap
 HARBOL_EXPORT char *harbol_cfg_get_cstr(struct HarbolLinkMap *const restrict cfgmap, const char key[restrict static 1])
 {
 	const struct HarbolVariant *const restrict var = __get_var(cfgmap, key);
-	return( var==NULL || var->tag != HarbolCfgType_String ) ? NULL : (*(struct HarbolString **)var->data)->cstr;
+	return( var==NULL || var->tag != HarbolCfgType_String ) ? NULL : harbol_string_cstr(*(struct HarbolString **)var->data);
 }
 
 HARBOL_EXPORT struct HarbolString *harbol_cfg_get_str(struct HarbolLinkMap *const restrict cfgmap, const char key[restrict static 1])
@@ -621,7 +646,7 @@ HARBOL_EXPORT enum HarbolCfgType harbol_cfg_get_type(struct HarbolLinkMap *const
 
 HARBOL_EXPORT bool harbol_cfg_set_str(struct HarbolLinkMap *const restrict cfgmap, const char keypath[restrict static 1], const struct HarbolString str, const bool override_convert)
 {
-	return harbol_cfg_set_cstr(cfgmap, keypath, str.cstr, override_convert);
+	return harbol_cfg_set_cstr(cfgmap, keypath, harbol_string_cstr(&str), override_convert);
 }
 
 HARBOL_EXPORT bool harbol_cfg_set_cstr(struct HarbolLinkMap *const restrict cfgmap, const char key[restrict static 1], const char cstr[restrict static 1], const bool override_convert)
@@ -755,11 +780,14 @@ static NO_NULL bool __harbol_cfg_build_file(const struct HarbolLinkMap *const ma
 {
 	const struct HarbolKeyVal **const end = harbol_linkmap_get_iter_end_count(map);
 	for( const struct HarbolKeyVal **iter = harbol_linkmap_get_iter(map); iter && iter<end; iter++ ) {
+		if( *iter==NULL )
+			continue;
+		
 		const struct HarbolVariant *v = (const struct HarbolVariant *)(*iter)->data;
 		const int32_t type = v->tag;
 		__write_tabs(file, tabs);
 		// using double pointer iterators as we need the key.
-		fprintf(file, "\"%s\": ", (*iter)->key.cstr);
+		fprintf(file, "\"%s\": ", harbol_string_cstr(&(*iter)->key));
 		
 		const union ConfigVal cv = {v->data};
 		switch( type ) {
@@ -773,7 +801,7 @@ static NO_NULL bool __harbol_cfg_build_file(const struct HarbolLinkMap *const ma
 				break;
 			
 			case HarbolCfgType_String:
-				fprintf(file, "\"%s\"\n", (*cv.str)->cstr); break;
+				fprintf(file, "\"%s\"\n", harbol_string_cstr(*cv.str)); break;
 			case HarbolCfgType_Float:
 				fprintf(file, "%" PRIfMAX "\n", *cv.f); break;
 			case HarbolCfgType_Int:
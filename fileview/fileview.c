@@ -0,0 +1,133 @@
+#ifndef _POSIX_C_SOURCE
+#	define _POSIX_C_SOURCE 200809L /* mmap & fileno aren't part of c99. */
+#endif
+#include "fileview.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+
+/* reads the rest of the stream into one null terminated heap buffer, 'hint' is how big the buffer starts if it's known. */
+static NO_NULL bool __harbol_fileview_read_stream(struct HarbolFileView *const view, FILE *const file, const size_t hint)
+{
+	size_t cap = ( hint > 0 ) ? hint : HARBOL_FILEVIEW_READ_CHUNK;
+	size_t len = 0;
+	char *buf = harbol_alloc(cap + 1, sizeof *buf);
+	if( buf==NULL )
+		return false;
+	
+	for( ;; ) {
+		if( len==cap ) {
+			/* a full buffer is usually the whole file when 'hint' came from fstat,
+			 * so probe for EOF with the terminator's byte before doubling the buffer.
+			 */
+			if( fread(&buf[len], sizeof *buf, 1, file)==0 ) {
+				if( ferror(file) ) {
+					harbol_free(buf);
+					return false;
+				}
+				break;
+			}
+			const size_t new_cap = harbol_grow_len(cap, cap + HARBOL_FILEVIEW_READ_CHUNK);
+			char *const new_buf = harbol_realloc(buf, new_cap + 1);
+			if( new_buf==NULL ) {
+				harbol_free(buf);
+				return false;
+			}
+			buf = new_buf, cap = new_cap;
+			len++; /* keep the probed byte. */
+		}
+		/* a short read only happens at EOF or on an error. */
+		const size_t want = cap - len;
+		const size_t got = fread(&buf[len], sizeof *buf, want, file);
+		len += got;
+		if( got < want ) {
+			if( ferror(file) ) {
+				harbol_free(buf);
+				return false;
+			}
+			break;
+		}
+	}
+	buf[len] = 0;
+	view->data = buf;
+	view->len = len;
+	view->mem = buf;
+	view->mapped = 0;
+	return true;
+}
+
+#ifndef OS_WINDOWS
+static NO_NULL bool __harbol_fileview_map(struct HarbolFileView *const view, const int fd, const size_t len)
+{
+	const long page = sysconf(_SC_PAGESIZE);
+	/* the kernel zero-fills the rest of the last page, that's the terminator. */
+	if( len==0 || page <= 0 || len % (size_t)page==0 )
+		return false;
+	
+	void *const mem = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+	if( mem==MAP_FAILED )
+		return false;
+	
+	posix_madvise(mem, len, POSIX_MADV_SEQUENTIAL);
+	view->data = mem;
+	view->len = len;
+	view->mem = mem;
+	view->mapped = len;
+	return true;
+}
+#endif
+
+HARBOL_EXPORT struct HarbolFileView harbol_fileview_create_from_file(FILE *const file)
+{
+	struct HarbolFileView view = EMPTY_HARBOL_FILEVIEW;
+	size_t hint = 0;
+#ifndef OS_WINDOWS
+	struct stat st;
+	const int fd = fileno(file);
+	if( fd >= 0 && fstat(fd, &st)==0 && S_ISREG(st.st_mode) ) {
+		if( __harbol_fileview_map(&view, fd, (size_t)st.st_size) )
+			return view;
+		
+		rewind(file);
+		hint = (size_t)st.st_size;
+	}
+#else
+	const ssize_t filesize = get_file_size(file);
+	if( filesize > 0 )
+		hint = (size_t)filesize;
+#endif
+	__harbol_fileview_read_stream(&view, file, hint);
+	return view;
+}
+
+HARBOL_EXPORT struct HarbolFileView harbol_fileview_create(const char filename[restrict static 1])
+{
+	struct HarbolFileView view = EMPTY_HARBOL_FILEVIEW;
+	FILE *file = fopen(filename, "rb");
+	if( file==NULL )
+		return view;
+	else {
+		view = harbol_fileview_create_from_file(file);
+		fclose(file), file=NULL;
+		return view;
+	}
+}
+
+HARBOL_EXPORT bool harbol_fileview_clear(struct HarbolFileView *const view)
+{
+#ifndef OS_WINDOWS
+	if( view->mapped > 0 )
+		munmap(view->mem, view->mapped);
+	else harbol_free(view->mem);
+#else
+	harbol_free(view->mem);
+#endif
+	*view = (struct HarbolFileView)EMPTY_HARBOL_FILEVIEW;
+	return true;
+}
@@ -0,0 +1,55 @@
+#ifndef HARBOL_FILEVIEW_INCLUDED
+#	define HARBOL_FILEVIEW_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+#include "../stringobj/stringobj.h"
+
+/* how much the heap path reads at a time when the stream's size isn't known. */
+#ifndef HARBOL_FILEVIEW_READ_CHUNK
+#	define HARBOL_FILEVIEW_READ_CHUNK    65536
+#endif
+
+
+/* read-only view of a whole file.
+ * regular files are mmapped with a sequential access hint, pipes & other non-seekable streams get read into one heap buffer instead.
+ * either way 'data' is always followed by a 0 byte so text can be parsed in place.
+ * files that are an exact multiple of the page size have nowhere to put that 0 byte so they also take the heap path.
+ */
+struct HarbolFileView {
+	const char *data;
+	size_t len;
+	void *mem;      // the mapping or heap buffer 'data' lives in.
+	size_t mapped;  // size of the mapping, 0 when 'mem' is a heap buffer.
+};
+
+#define EMPTY_HARBOL_FILEVIEW    {NULL,0,NULL,0}
+
+/* 'data' is NULL if the file couldn't be opened or read. */
+HARBOL_EXPORT NO_NULL struct HarbolFileView harbol_fileview_create(const char filename[]);
+
+/* regular files are viewed whole, anything else is read from wherever the stream is up to EOF. the view doesn't keep 'file'. */
+HARBOL_EXPORT NO_NULL struct HarbolFileView harbol_fileview_create_from_file(FILE *file);
+HARBOL_EXPORT NO_NULL bool harbol_fileview_clear(struct HarbolFileView *view);
+
+static inline NO_NULL bool harbol_fileview_is_mapped(const struct HarbolFileView *const view)
+{
+	return view->mapped > 0;
+}
+
+static inline NO_NULL struct HarbolStrView harbol_fileview_strview(const struct HarbolFileView *const view)
+{
+	return (struct HarbolStrView){ view->data, view->len };
+}
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_FILEVIEW_INCLUDED */
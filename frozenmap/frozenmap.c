@@ -0,0 +1,340 @@
+#include "frozenmap.h"
+#include "../map/map_group.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+#define HARBOL_FROZENMAP_MAGIC         "HRBLFMAP"
+#define HARBOL_FROZENMAP_BYTE_ORDER    0x0102030405060708ull
+
+/* average keys per pilot, fewer makes pilots easier to find at the cost of a bigger pilot array. */
+#ifndef HARBOL_FROZENMAP_BUCKET_KEYS
+#	define HARBOL_FROZENMAP_BUCKET_KEYS    4
+#endif
+
+enum {
+	HARBOL_FROZENMAP_MAX_PILOT = 1 << 24,
+	HARBOL_FROZENMAP_MAX_SEEDS = 8,
+};
+
+/* fixed width fields only so the layout doesn't depend on the compiler. */
+struct HarbolFrozenMapHeader {
+	char magic[8];
+	uint64_t byte_order, seed, count, buckets, datasize, stride, size;
+	uint64_t pilots, slots, data, keys; // offsets from the start of the block.
+};
+
+struct HarbolFrozenMapSlot {
+	uint32_t key, len; // offset & length of the key bytes.
+};
+
+struct __HarbolFrozenMapSrc {
+	const char *key;
+	const uint8_t *data;
+	size_t len;
+	uint64_t hash;
+};
+
+
+/* counts are capped at 32 bits so a multiply & shift can map a hash onto [0, n) instead of a division. */
+static inline size_t __harbol_frozenmap_bucket(const uint64_t hash, const size_t buckets)
+{
+	return (size_t)(((hash & 0xFFFFFFFFull) * buckets) >> 32);
+}
+
+static inline size_t __harbol_frozenmap_slot(const uint64_t hash, const uint32_t pilot, const size_t count)
+{
+	/* the key's hash is already good, the pilot only needs a cheap remix to displace it. */
+	uint64_t x = hash ^ (pilot * 0x9E3779B97F4A7C15ull);
+	x = (x ^ (x >> 29)) * 0xBF58476D1CE4E5B9ull;
+	return (size_t)(((x >> 32) * count) >> 32);
+}
+
+static inline const struct HarbolFrozenMapHeader *__harbol_frozenmap_header(const struct HarbolFrozenMap *const fmap)
+{
+	return (const struct HarbolFrozenMapHeader *)fmap->block;
+}
+
+static int __harbol_frozenmap_cmp_bucket_size(const void *const a, const void *const b)
+{
+	/* pairs of [size, bucket], biggest first. */
+	const size_t *const x = a, *const y = b;
+	return( x[0] < y[0] ) - ( x[0] > y[0] );
+}
+
+/* hash & displace: keys are split into buckets and each bucket gets the first pilot that puts all of its keys into free slots.
+ * going from the biggest bucket to the smallest means the hard buckets get placed while the table is still mostly empty.
+ * 'slot_src' gets which source key ended up in each slot.
+ */
+static NO_NULL bool __harbol_frozenmap_find_pilots(struct __HarbolFrozenMapSrc srcs[static 1], const size_t count, const size_t buckets, const uint64_t seed, uint32_t pilots[static 1], uint32_t slot_src[static 1])
+{
+	for( uindex_t i=0; i<count; i++ )
+		srcs[i].hash = harbol_hash_bytes(srcs[i].key, srcs[i].len, seed);
+	
+	size_t *const starts = harbol_alloc(buckets + 1, sizeof *starts);
+	size_t *const order = harbol_alloc(buckets * 2, sizeof *order);
+	uint32_t *const members = harbol_alloc(count, sizeof *members);
+	bool result = starts != NULL && order != NULL && members != NULL;
+	if( result ) {
+		for( uindex_t i=0; i<count; i++ )
+			starts[__harbol_frozenmap_bucket(srcs[i].hash, buckets) + 1]++;
+		for( uindex_t b=0; b<buckets; b++ ) {
+			order[b * 2] = starts[b + 1];
+			order[b * 2 + 1] = b;
+			starts[b + 1] += starts[b];
+		}
+		for( uindex_t i=0; i<count; i++ ) {
+			const size_t b = __harbol_frozenmap_bucket(srcs[i].hash, buckets);
+			members[starts[b] + --order[b * 2]] = i;
+		}
+		for( uindex_t b=0; b<buckets; b++ )
+			order[b * 2] = starts[b + 1] - starts[b];
+		qsort(order, buckets, sizeof *order * 2, __harbol_frozenmap_cmp_bucket_size);
+		
+		for( uindex_t i=0; i<count; i++ )
+			slot_src[i] = UINT32_MAX;
+		
+		for( uindex_t o=0; o<buckets && result; o++ ) {
+			const size_t b = order[o * 2 + 1];
+			const uint32_t *const keys = &members[starts[b]];
+			const size_t size = order[o * 2];
+			bool placed = (size==0);
+			for( uint32_t pilot=0; !placed && pilot<HARBOL_FROZENMAP_MAX_PILOT; pilot++ ) {
+				size_t k = 0;
+				for( ; k<size; k++ ) {
+					const size_t slot = __harbol_frozenmap_slot(srcs[keys[k]].hash, pilot, count);
+					if( slot_src[slot] != UINT32_MAX )
+						break;
+					slot_src[slot] = keys[k];
+				}
+				if( k==size ) {
+					pilots[b] = pilot;
+					placed = true;
+				} else {
+					/* undo this pilot's partial placement. */
+					while( k-- > 0 )
+						slot_src[__harbol_frozenmap_slot(srcs[keys[k]].hash, pilot, count)] = UINT32_MAX;
+				}
+			}
+			/* only happens with keys whose full hashes collide, a different seed fixes that. */
+			result = placed;
+		}
+	}
+	harbol_free(starts);
+	harbol_free(order);
+	harbol_free(members);
+	return result;
+}
+
+static struct HarbolFrozenMap __harbol_frozenmap_build(struct __HarbolFrozenMapSrc srcs[const], const size_t count, const size_t datasize)
+{
+	struct HarbolFrozenMap fmap = EMPTY_HARBOL_FROZENMAP;
+	const size_t buckets = (count + HARBOL_FROZENMAP_BUCKET_KEYS - 1) / HARBOL_FROZENMAP_BUCKET_KEYS;
+	const size_t stride = harbol_align_size(datasize, sizeof(uint64_t));
+	
+	size_t key_bytes = 0;
+	for( uindex_t i=0; i<count; i++ )
+		key_bytes += srcs[i].len + 1;
+	
+	struct HarbolFrozenMapHeader header = {
+		.magic = HARBOL_FROZENMAP_MAGIC,
+		.byte_order = HARBOL_FROZENMAP_BYTE_ORDER,
+		.count = count,
+		.buckets = buckets,
+		.datasize = datasize,
+		.stride = stride
+	};
+	header.pilots = harbol_align_size(sizeof header, sizeof(uint64_t));
+	header.slots = harbol_align_size(header.pilots + buckets * sizeof(uint32_t), sizeof(uint64_t));
+	header.data = harbol_align_size(header.slots + count * sizeof(struct HarbolFrozenMapSlot), 2 * sizeof(uintptr_t));
+	header.keys = header.data + count * stride;
+	header.size = harbol_align_size(header.keys + key_bytes, sizeof(uint64_t));
+	
+	/* key offsets are 32-bit. */
+	if( header.size > UINT32_MAX || count > UINT32_MAX )
+		return fmap;
+	
+	uint8_t *const block = harbol_alloc(header.size, sizeof *block);
+	if( block==NULL )
+		return fmap;
+	
+	uint32_t *const pilots = (uint32_t *)&block[header.pilots];
+	uint32_t *const slot_src = harbol_alloc(count + 1, sizeof *slot_src);
+	bool found = (count==0);
+	for( uindex_t attempt=0; !found && slot_src != NULL && attempt<HARBOL_FROZENMAP_MAX_SEEDS; attempt++ ) {
+		header.seed = harbol_hash_seed();
+		found = __harbol_frozenmap_find_pilots(srcs, count, buckets, header.seed, pilots, slot_src);
+	}
+	if( !found ) {
+		harbol_free(slot_src);
+		harbol_free(block);
+		return fmap;
+	}
+	
+	struct HarbolFrozenMapSlot *const slots = (struct HarbolFrozenMapSlot *)&block[header.slots];
+	size_t key_offs = header.keys;
+	for( uindex_t i=0; i<count; i++ ) {
+		const struct __HarbolFrozenMapSrc *const src = &srcs[slot_src[i]];
+		slots[i].key = key_offs;
+		slots[i].len = src->len;
+		memcpy(&block[key_offs], src->key, src->len);
+		key_offs += src->len + 1;
+		memcpy(&block[header.data + i * stride], src->data, datasize);
+	}
+	memcpy(block, &header, sizeof header);
+	harbol_free(slot_src);
+	
+	fmap.block = block;
+	fmap.size = header.size;
+	fmap.owned = true;
+	return fmap;
+}
+
+
+HARBOL_EXPORT struct HarbolFrozenMap harbol_frozenmap_create_from_map(const struct HarbolMap *const map)
+{
+	struct HarbolFrozenMap fmap = EMPTY_HARBOL_FROZENMAP;
+	struct __HarbolFrozenMapSrc *const srcs = harbol_alloc(map->count + 1, sizeof *srcs);
+	if( srcs==NULL )
+		return fmap;
+	
+	size_t n = 0;
+	for( uindex_t i=0; i<map->len; i++ )
+		if( map->ctrl[i] < HarbolMapCtrl_Empty )
+			srcs[n++] = (struct __HarbolFrozenMapSrc){ harbol_string_cstr(&map->buckets[i]->key), map->buckets[i]->data, harbol_string_len(&map->buckets[i]->key), 0 };
+	
+	/* pairs that haven't been migrated yet. */
+	for( uindex_t i=map->old.cursor; i<map->old.len; i++ )
+		if( map->old.ctrl[i] < HarbolMapCtrl_Empty )
+			srcs[n++] = (struct __HarbolFrozenMapSrc){ harbol_string_cstr(&map->old.buckets[i]->key), map->old.buckets[i]->data, harbol_string_len(&map->old.buckets[i]->key), 0 };
+	
+	fmap = __harbol_frozenmap_build(srcs, n, map->datasize);
+	harbol_free(srcs);
+	return fmap;
+}
+
+HARBOL_EXPORT struct HarbolFrozenMap harbol_frozenmap_create_from_linkmap(const struct HarbolLinkMap *const map)
+{
+	struct HarbolFrozenMap fmap = EMPTY_HARBOL_FROZENMAP;
+	struct __HarbolFrozenMapSrc *const srcs = harbol_alloc(map->count + 1, sizeof *srcs);
+	if( srcs==NULL )
+		return fmap;
+	
+	size_t n = 0;
+	const struct HarbolKeyVal *const *const end = harbol_linkmap_get_iter_end_count(map);
+	for( const struct HarbolKeyVal *const *iter = harbol_linkmap_get_iter(map); iter && iter<end; iter++ )
+		if( *iter != NULL )
+			srcs[n++] = (struct __HarbolFrozenMapSrc){ harbol_string_cstr(&(*iter)->key), (*iter)->data, harbol_string_len(&(*iter)->key), 0 };
+	
+	fmap = __harbol_frozenmap_build(srcs, n, map->datasize);
+	harbol_free(srcs);
+	return fmap;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_create_from_block(struct HarbolFrozenMap *const restrict fmap, const void *const restrict block, const size_t size)
+{
+	const struct HarbolFrozenMapHeader *const header = block;
+	if( size < sizeof *header || !is_aligned(block, sizeof(uint64_t)) )
+		return false;
+	else if( memcmp(header->magic, HARBOL_FROZENMAP_MAGIC, sizeof header->magic) || header->byte_order != HARBOL_FROZENMAP_BYTE_ORDER || header->size != size )
+		return false;
+	else if( header->count > 0 && header->buckets==0 )
+		return false;
+	
+	/* a block could come from anywhere so make sure every offset stays inside it. */
+	if( header->pilots > size || header->buckets > (size - header->pilots) / sizeof(uint32_t)
+			|| header->slots > size || header->count > (size - header->slots) / sizeof(struct HarbolFrozenMapSlot)
+			|| header->stride < header->datasize || header->data > size || (header->stride > 0 && header->count > (size - header->data) / header->stride)
+			|| header->keys > size )
+		return false;
+	
+	const uint8_t *const bytes = block;
+	const struct HarbolFrozenMapSlot *const slots = (const struct HarbolFrozenMapSlot *)&bytes[header->slots];
+	for( uindex_t i=0; i<header->count; i++ )
+		if( slots[i].key < header->keys || (uint64_t)slots[i].key + slots[i].len >= size )
+			return false;
+	
+	fmap->block = bytes;
+	fmap->size = size;
+	fmap->owned = false;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_clear(struct HarbolFrozenMap *const fmap)
+{
+	if( fmap->block==NULL )
+		return false;
+	else {
+		if( fmap->owned )
+			harbol_free((uint8_t *)fmap->block);
+		*fmap = (struct HarbolFrozenMap)EMPTY_HARBOL_FROZENMAP;
+		return true;
+	}
+}
+
+HARBOL_EXPORT const void *harbol_frozenmap_get(const struct HarbolFrozenMap *const restrict fmap, const char key[restrict static 1])
+{
+	const struct HarbolFrozenMapHeader *const header = __harbol_frozenmap_header(fmap);
+	if( header==NULL || header->count==0 )
+		return NULL;
+	else {
+		size_t keylen = 0;
+		const uint64_t hash = harbol_hash_cstr(key, header->seed, &keylen);
+		const uint32_t *const pilots = (const uint32_t *)&fmap->block[header->pilots];
+		const size_t slot = __harbol_frozenmap_slot(hash, pilots[__harbol_frozenmap_bucket(hash, header->buckets)], header->count);
+		const struct HarbolFrozenMapSlot *const s = &((const struct HarbolFrozenMapSlot *)&fmap->block[header->slots])[slot];
+		return( s->len==keylen && !memcmp(&fmap->block[s->key], key, keylen) ) ? &fmap->block[header->data + slot * header->stride] : NULL;
+	}
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_has_key(const struct HarbolFrozenMap *const restrict fmap, const char key[restrict static 1])
+{
+	return harbol_frozenmap_get(fmap, key) != NULL;
+}
+
+HARBOL_EXPORT size_t harbol_frozenmap_count(const struct HarbolFrozenMap *const fmap)
+{
+	return( fmap->block==NULL ) ? 0 : __harbol_frozenmap_header(fmap)->count;
+}
+
+HARBOL_EXPORT size_t harbol_frozenmap_datasize(const struct HarbolFrozenMap *const fmap)
+{
+	return( fmap->block==NULL ) ? 0 : __harbol_frozenmap_header(fmap)->datasize;
+}
+
+HARBOL_EXPORT bool harbol_frozenmap_write_file(const struct HarbolFrozenMap *const restrict fmap, const char filename[restrict static 1])
+{
+	if( fmap->block==NULL )
+		return false;
+	
+	FILE *file = fopen(filename, "wb");
+	if( file==NULL )
+		return false;
+	else {
+		const bool result = fwrite(fmap->block, sizeof *fmap->block, fmap->size, file)==fmap->size;
+		fclose(file), file=NULL;
+		return result;
+	}
+}
+
+HARBOL_EXPORT struct HarbolFrozenMap harbol_frozenmap_read_file(const char filename[restrict static 1])
+{
+	struct HarbolFrozenMap fmap = EMPTY_HARBOL_FROZENMAP;
+	FILE *file = fopen(filename, "rb");
+	if( file==NULL )
+		return fmap;
+	
+	const ssize_t filesize = get_file_size(file);
+	uint8_t *block = ( filesize > 0 ) ? harbol_alloc(filesize, sizeof *block) : NULL;
+	const bool read = block != NULL && fread(block, sizeof *block, filesize, file)==(size_t)filesize;
+	fclose(file), file=NULL;
+	
+	if( !read || !harbol_frozenmap_create_from_block(&fmap, block, filesize) ) {
+		harbol_free(block);
+		return fmap;
+	}
+	fmap.owned = true;
+	return fmap;
+}
@@ -0,0 +1,50 @@
+#ifndef HARBOL_FROZENMAP_INCLUDED
+#	define HARBOL_FROZENMAP_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+#include "../map/map.h"
+#include "../linkmap/linkmap.h"
+
+
+/* read-only, minimal perfect hash table made from a map that's done being written to.
+ * every key gets its own slot so a lookup is one key hash, one slot, and one key compare.
+ *
+ * the whole table is a single block of header, pilots, slots, data, and key bytes.
+ * everything inside the block is an offset from its start so it can be written to a file and loaded or mmapped back as-is.
+ * blocks are in native byte order.
+ */
+struct HarbolFrozenMap {
+	const uint8_t *block;
+	size_t size;
+	bool owned; // false when the block is borrowed, like from an mmapped file.
+};
+
+#define EMPTY_HARBOL_FROZENMAP    {NULL,0,false}
+
+HARBOL_EXPORT NO_NULL struct HarbolFrozenMap harbol_frozenmap_create_from_map(const struct HarbolMap *map);
+HARBOL_EXPORT NO_NULL struct HarbolFrozenMap harbol_frozenmap_create_from_linkmap(const struct HarbolLinkMap *map);
+
+/* borrows an existing block after checking it's a valid frozen map, the block has to be 8-byte aligned. */
+HARBOL_EXPORT NO_NULL bool harbol_frozenmap_create_from_block(struct HarbolFrozenMap *fmap, const void *block, size_t size);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_frozenmap_clear(struct HarbolFrozenMap *fmap);
+
+HARBOL_EXPORT NO_NULL const void *harbol_frozenmap_get(const struct HarbolFrozenMap *fmap, const char key[]);
+HARBOL_EXPORT NO_NULL bool harbol_frozenmap_has_key(const struct HarbolFrozenMap *fmap, const char key[]);
+HARBOL_EXPORT NO_NULL size_t harbol_frozenmap_count(const struct HarbolFrozenMap *fmap);
+HARBOL_EXPORT NO_NULL size_t harbol_frozenmap_datasize(const struct HarbolFrozenMap *fmap);
+
+HARBOL_EXPORT NO_NULL bool harbol_frozenmap_write_file(const struct HarbolFrozenMap *fmap, const char filename[]);
+HARBOL_EXPORT NO_NULL struct HarbolFrozenMap harbol_frozenmap_read_file(const char filename[]);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_FROZENMAP_INCLUDED */
@@ -11,9 +11,14 @@
 ******************************************************************
 *****************************************************************/
 HARBOL_EXPORT struct HarbolEdge harbol_edge_create(void *const data, const size_t datasize, const index_t link)
+{
+	return harbol_edge_create_with(data, datasize, link, NULL);
+}
+
+HARBOL_EXPORT struct HarbolEdge harbol_edge_create_with(void *const data, const size_t datasize, const index_t link, const struct HarbolAllocator *const alloc)
 {
 	struct HarbolEdge edge = EMPTY_HARBOL_EDGE;
-	edge.weight = harbol_alloc(datasize, sizeof *edge.weight);
+	edge.weight = harbol_alloc_with(alloc, datasize, sizeof *edge.weight);
 	if( edge.weight != NULL ) {
 		edge.link = link;
 		memcpy(edge.weight, data, datasize);
@@ -21,17 +26,22 @@ HARBOL_EXPORT struct HarbolEdge harbol_edge_create(void *const data, const size_
 	return edge;
 }
 
-HARBOL_EXPORT bool harbol_edge_clear(struct HarbolEdge *const edge, void dtor(void**))
+static NEVER_NULL(2) bool __harbol_edge_destroy(const struct HarbolAllocator *const alloc, struct HarbolEdge *const edge, void dtor(void**))
 {
 	if( dtor != NULL )
 		dtor((void**)&edge->weight);
 	
 	if( edge->weight != NULL )
-		harbol_free(edge->weight), edge->weight=NULL;
+		harbol_free_with(alloc, edge->weight), edge->weight=NULL;
 	edge->link = -1;
 	return true;
 }
 
+HARBOL_EXPORT bool harbol_edge_clear(struct HarbolEdge *const edge, void dtor(void**))
+{
+	return __harbol_edge_destroy(NULL, edge, dtor);
+}
+
 HARBOL_EXPORT void *harbol_edge_get(const struct HarbolEdge *const edge)
 {
 	return edge->weight;
@@ -58,11 +68,17 @@ HARBOL_EXPORT bool harbol_edge_set(struct HarbolEdge *const restrict edge, void
 ******************************************************************
 *****************************************************************/
 HARBOL_EXPORT struct HarbolVertex harbol_vertex_create(void *data, size_t datasize)
+{
+	return harbol_vertex_create_with(data, datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolVertex harbol_vertex_create_with(void *const data, const size_t datasize, const struct HarbolAllocator *const alloc)
 {
 	struct HarbolVertex vert = EMPTY_HARBOL_VERT;
-	vert.data = harbol_alloc(datasize, sizeof *vert.data);
+	vert.edges.alloc = alloc;
+	vert.data = harbol_alloc_with(alloc, datasize, sizeof *vert.data);
 	if( vert.data != NULL ) {
-		vert.edges = harbol_vector_create(sizeof(struct HarbolEdge), VEC_DEFAULT_SIZE);
+		vert.edges = harbol_vector_create_with(sizeof(struct HarbolEdge), VEC_DEFAULT_SIZE, alloc);
 		memcpy(vert.data, data, datasize);
 	}
 	return vert;
@@ -71,14 +87,14 @@ HARBOL_EXPORT struct HarbolVertex harbol_vertex_create(void *data, size_t datasi
 HARBOL_EXPORT bool harbol_vertex_clear(struct HarbolVertex *const vert, void vert_dtor(void**), void edge_dtor(void**))
 {
 	for( size_t i=0; i<vert->edges.count; i++ )
-		harbol_edge_clear(harbol_vector_get(&vert->edges, i), edge_dtor);
+		__harbol_edge_destroy(vert->edges.alloc, harbol_vector_get(&vert->edges, i), edge_dtor);
 	harbol_vector_clear(&vert->edges, NULL);
 	
 	if( vert_dtor != NULL )
 		vert_dtor((void**)&vert->data);
 	
 	if( vert->data != NULL )
-		harbol_free(vert->data), vert->data=NULL;
+		harbol_free_with(vert->edges.alloc, vert->data), vert->data=NULL;
 	return true;
 }
 
@@ -92,7 +108,7 @@ HARBOL_EXPORT bool harbol_vertex_set(struct HarbolVertex *const restrict vert, v
 	if( datasize==0 )
 		return false;
 	else if( vert->data==NULL ) {
-		vert->data = harbol_alloc(datasize, sizeof *vert->data);
+		vert->data = harbol_alloc_with(vert->edges.alloc, datasize, sizeof *vert->data);
 		return( vert->data==NULL ) ? false : memcpy(vert->data, data, datasize) != NULL;
 	} else {
 		return memcpy(vert->data, data, datasize) != NULL;
@@ -115,7 +131,7 @@ HARBOL_EXPORT bool harbol_vertex_del_index(struct HarbolVertex *const vert, cons
 	if( del_edge==NULL )
 		return false;
 	else {
-		harbol_edge_clear(del_edge, dtor);
+		__harbol_edge_destroy(vert->edges.alloc, del_edge, dtor);
 		harbol_vector_del(&vert->edges, index, NULL);
 		return true;
 	}
@@ -123,7 +139,7 @@ HARBOL_EXPORT bool harbol_vertex_del_index(struct HarbolVertex *const vert, cons
 
 HARBOL_EXPORT bool harbol_vertex_del_edge(struct HarbolVertex *const vert, struct HarbolEdge *const edge, void dtor(void**))
 {
-	harbol_edge_clear(edge, dtor);
+	__harbol_edge_destroy(vert->edges.alloc, edge, dtor);
 	const index_t i = harbol_vector_index_of(&vert->edges, edge, 0);
 	harbol_vector_del(&vert->edges, i, NULL);
 	return true;
@@ -141,11 +157,16 @@ HARBOL_EXPORT struct HarbolGraph *harbol_graph_new(const size_t vert_datasize, c
 }
 
 HARBOL_EXPORT struct HarbolGraph harbol_graph_create(const size_t vert_datasize, const size_t edge_datasize)
+{
+	return harbol_graph_create_with(vert_datasize, edge_datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolGraph harbol_graph_create_with(const size_t vert_datasize, const size_t edge_datasize, const struct HarbolAllocator *const alloc)
 {
 	struct HarbolGraph g = EMPTY_HARBOL_GRAPH;
 	g.vert_datasize = vert_datasize;
 	g.edge_datasize = edge_datasize;
-	g.vertices = harbol_vector_create(sizeof(struct HarbolVertex), VEC_DEFAULT_SIZE);
+	g.vertices = harbol_vector_create_with(sizeof(struct HarbolVertex), VEC_DEFAULT_SIZE, alloc);
 	return g;
 }
 
@@ -189,7 +210,7 @@ HARBOL_EXPORT bool harbol_graph_add_vert(struct HarbolGraph *const restrict grap
 	if( graph->vert_datasize==0 )
 		return false;
 	else {
-		struct HarbolVertex vert = harbol_vertex_create(val, graph->vert_datasize);
+		struct HarbolVertex vert = harbol_vertex_create_with(val, graph->vert_datasize, graph->vertices.alloc);
 		return harbol_vector_insert(&graph->vertices, &vert);
 	}
 }
@@ -260,7 +281,7 @@ HARBOL_EXPORT bool harbol_graph_set_index(struct HarbolGraph *const restrict gra
 
 HARBOL_EXPORT bool harbol_graph_vert_add_edge(struct HarbolGraph *const restrict graph, struct HarbolVertex *const restrict vert, const index_t link, void *const restrict val)
 {
-	struct HarbolEdge edge = harbol_edge_create(val, graph->edge_datasize, link);
+	struct HarbolEdge edge = harbol_edge_create_with(val, graph->edge_datasize, link, vert->edges.alloc);
 	return harbol_vector_insert(&vert->edges, &edge);
 }
 
@@ -270,7 +291,7 @@ HARBOL_EXPORT bool harbol_graph_index_add_edge(struct HarbolGraph *const restric
 	if( vert==NULL )
 		return false;
 	else {
-		struct HarbolEdge edge = harbol_edge_create(val, graph->edge_datasize, link);
+		struct HarbolEdge edge = harbol_edge_create_with(val, graph->edge_datasize, link, vert->edges.alloc);
 		return harbol_vector_insert(&vert->edges, &edge);
 	}
 }
@@ -18,6 +18,7 @@ struct HarbolEdge {
 
 
 HARBOL_EXPORT NO_NULL struct HarbolEdge harbol_edge_create(void *data, size_t datasize, index_t link);
+HARBOL_EXPORT NEVER_NULL(1) struct HarbolEdge harbol_edge_create_with(void *data, size_t datasize, index_t link, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_edge_clear(struct HarbolEdge *edge, void dtor(void**));
 
 HARBOL_EXPORT NO_NULL void *harbol_edge_get(const struct HarbolEdge *edge);
@@ -25,13 +26,14 @@ HARBOL_EXPORT NO_NULL bool harbol_edge_set(struct HarbolEdge *edge, void *data,
 
 
 struct HarbolVertex {
-	struct HarbolVector edges;
+	struct HarbolVector edges; // the edges' allocator is the vertex's allocator too.
 	uint8_t *data;
 };
 
 #define EMPTY_HARBOL_VERT    { EMPTY_HARBOL_VECTOR, NULL }
 
 HARBOL_EXPORT NO_NULL struct HarbolVertex harbol_vertex_create(void *data, size_t datasize);
+HARBOL_EXPORT NEVER_NULL(1) struct HarbolVertex harbol_vertex_create_with(void *data, size_t datasize, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_vertex_clear(struct HarbolVertex *vert, void vert_dtor(void**), void edge_dtor(void**));
 
 HARBOL_EXPORT NO_NULL void *harbol_vertex_get(const struct HarbolVertex *vert);
@@ -46,7 +48,7 @@ HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_vertex_del_edge(struct HarbolVertex *
 
 // Adjacency List Graph Implementation.
 struct HarbolGraph {
-	struct HarbolVector vertices;
+	struct HarbolVector vertices; // vertices and edges all use this vector's allocator.
 	size_t vert_datasize, edge_datasize;
 };
 
@@ -54,6 +56,7 @@ struct HarbolGraph {
 
 HARBOL_EXPORT struct HarbolGraph *harbol_graph_new(size_t vert_datasize, size_t edge_datasize);
 HARBOL_EXPORT struct HarbolGraph harbol_graph_create(size_t vert_datasize, size_t edge_datasize);
+HARBOL_EXPORT struct HarbolGraph harbol_graph_create_with(size_t vert_datasize, size_t edge_datasize, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_graph_clear(struct HarbolGraph *graph, void vert_dtor(void**), void edge_dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_graph_free(struct HarbolGraph **graphref, void vert_dtor(void**), void edge_dtor(void**));
 
@@ -33,6 +33,7 @@ extern "C" {
 
 /************* C++ Style Automated String *************/
 #include "stringobj/stringobj.h"
+#include "stringobj/strbuilder.h"
 /******************************************************/
 
 /************* Dynamic Array *************/
@@ -53,12 +54,25 @@ extern "C" {
 
 /************* Byte Buffer *************/
 #include "bytebuffer/bytebuffer.h"
+#include "bytebuffer/segbuf.h"
 /**************************************/
 
+/************* Seeded Hash Functions *************/
+#include "hash/hash.h"
+/*************************************************/
+
 /************* String-based Hash Table *************/
 #include "map/map.h"
 /***************************************************/
 
+/************* Integer-keyed Hash Table *************/
+#include "map/intmap.h"
+/****************************************************/
+
+/************* Concurrent Hash Table *************/
+#include "map/concmap.h"
+/*************************************************/
+
 /************* Weight Adjacency List Graph *************/
 #include "graph/graph.h"
 /*******************************************************/
@@ -71,6 +85,10 @@ extern "C" {
 #include "linkmap/linkmap.h"
 /**********************************************************************/
 
+/************* Frozen Minimal Perfect Hash Table *************/
+#include "frozenmap/frozenmap.h"
+/*************************************************************/
+
 /************* Variant Type *************/
 #include "variant/variant.h"
 /****************************************/
@@ -91,6 +109,10 @@ extern "C" {
 #include "lex/lex.h"
 /*********************************************************/
 
+/************* Read-only File View *************/
+#include "fileview/fileview.h"
+/***********************************************/
+
 #ifdef __cplusplus
 }
 #endif
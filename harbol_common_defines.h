@@ -147,6 +147,15 @@
 #	endif
 #endif
 
+/* setup macro to hint that memory at an address will be read soon. */
+#ifndef HARBOL_PREFETCH
+#	if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+#		define HARBOL_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#	else
+#		define HARBOL_PREFETCH(addr) ((void)(addr))
+#	endif
+#endif
+
 /* setup macro that marks a function as having hidden visibility. */
 #ifndef VIS_HIDDEN
 #	if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
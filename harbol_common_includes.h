@@ -214,45 +214,88 @@ inline void harbol_clean(void **const ptrref)
 #endif
 }
 
-static inline bool harbol_generic_vector_resizer(void *const vec, const size_t new_size, const size_t element_size)
+/* runtime allocator that containers can be created with, a NULL allocator means the default 'harbol_alloc' family above.
+ * 'alloc' must hand back zeroed memory, 'realloc' is given the old size so arenas can move blocks without headers.
+ */
+struct HarbolAllocator {
+	void *(*alloc)(void *userdata, size_t bytes);
+	void *(*realloc)(void *userdata, void *ptr, size_t old_bytes, size_t new_bytes);
+	void (*free)(void *userdata, void *ptr);
+	void *userdata;
+};
+
+static inline void *harbol_alloc_with(const struct HarbolAllocator *const alloc, const size_t num, const size_t size)
+{
+	if( alloc==NULL )
+		return harbol_alloc(num, size);
+	/* calloc refuses a 'num * size' that wraps, custom allocators only ever see the product so check it here. */
+	else if( size != 0 && num > SIZE_MAX / size )
+		return NULL;
+	else return alloc->alloc(alloc->userdata, num * size);
+}
+
+static inline void *harbol_realloc_with(const struct HarbolAllocator *const alloc, void *const ptr, const size_t old_bytes, const size_t bytes)
+{
+	return( alloc==NULL ) ? harbol_realloc(ptr, bytes) : alloc->realloc(alloc->userdata, ptr, old_bytes, bytes);
+}
+
+static inline void harbol_free_with(const struct HarbolAllocator *const alloc, void *const ptr)
+{
+	if( alloc==NULL )
+		harbol_free(ptr);
+	else if( ptr != NULL )
+		alloc->free(alloc->userdata, ptr);
+}
+
+/* growable containers multiply their capacity by 'HARBOL_GROWTH_NUM / HARBOL_GROWTH_DEN' when they fill up.
+ * something like 3/2 wastes less memory and lets realloc reuse freed blocks, 2/1 does fewer reallocs.
+ */
+#ifndef HARBOL_GROWTH_NUM
+#	define HARBOL_GROWTH_NUM    2
+#endif
+
+#ifndef HARBOL_GROWTH_DEN
+#	define HARBOL_GROWTH_DEN    1
+#endif
+
+/* next capacity after 'len' that holds at least 'needed' elements. */
+static inline size_t harbol_grow_len(const size_t len, const size_t needed)
+{
+	const size_t grown = (len / HARBOL_GROWTH_DEN) * HARBOL_GROWTH_NUM + ((len % HARBOL_GROWTH_DEN) * HARBOL_GROWTH_NUM) / HARBOL_GROWTH_DEN;
+	const size_t new_len = (grown > len) ? grown : len + 1;
+	return( new_len < needed ) ? needed : new_len;
+}
+
+/* resizes any struct that starts with a table pointer and its length.
+ * growing reallocs in place when it can and zeroes only the new tail, so elements past 'count' read as zero like before.
+ */
+static inline bool harbol_generic_vector_resizer(void *const vec, const size_t new_size, const size_t element_size, const struct HarbolAllocator *const alloc)
 {
 	struct {
 		uint8_t *tab;
 		size_t len;
 	} *restrict obj = vec;
 	
-	// first we get our old size.
-	// then resize the actual size.
 	const size_t old_size = obj->len;
 	if( old_size==new_size )
 		return true;
-	else {
-		const bool increasing_mem = (old_size < new_size);
-		if( increasing_mem ) {
-			// allocate new table.
-			uint8_t *const newdata = harbol_alloc(new_size, element_size);
-			if( newdata==NULL ) {
-				return false;
-			} else {
-				obj->len = new_size;
-				// copy the old table to new then free old table.
-				if( obj->tab != NULL ) {
-					memcpy(newdata, obj->tab, element_size * old_size);
-					harbol_free(obj->tab), obj->tab = NULL;
-				}
-				obj->tab = newdata;
-				return true;
-			}
+	else if( new_size==0 ) {
+		harbol_free_with(alloc, obj->tab), obj->tab = NULL;
+		obj->len = 0;
+		return true;
+	} else if( element_size != 0 && new_size > SIZE_MAX / element_size ) {
+		/* the byte count would wrap, realloc would hand back a tiny block that the memset then overruns. */
+		return false;
+	} else {
+		uint8_t *const result = harbol_realloc_with(alloc, obj->tab, element_size * old_size, element_size * new_size);
+		if( result==NULL ) {
+			return false;
 		} else {
-			uint8_t *result = harbol_realloc(obj->tab, element_size * new_size);
-			if( result==NULL ) {
-				return false;
-			} else {
-				if( result != obj->tab )
-					obj->tab = result;
-				obj->len = new_size;
-				return true;
-			}
+			if( new_size > old_size )
+				memset(&result[element_size * old_size], 0, element_size * (new_size - old_size));
+			obj->tab = result;
+			obj->len = new_size;
+			return true;
 		}
 	}
 }
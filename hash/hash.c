@@ -0,0 +1,139 @@
+#include "hash.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+#include <time.h>
+#ifdef COMPILER_MSVC
+#	include <intrin.h>
+#endif
+
+
+/* based on wyhash final version 4 by Wang Yi, released into the public domain. */
+static const uint64_t __harbol_hash_secret[4] = {
+	0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+	0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+static inline NO_NULL void __harbol_hash_mum(uint64_t *const restrict a, uint64_t *const restrict b)
+{
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t r = (__uint128_t)*a * *b;
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	const uint64_t
+		ha = *a >> 32, hb = *b >> 32,
+		la = (uint32_t)*a, lb = (uint32_t)*b
+	;
+	const uint64_t
+		rh = ha * hb, rm0 = ha * lb,
+		rm1 = hb * la, rl = la * lb,
+		t = rl + (rm0 << 32)
+	;
+	uint64_t c = t < rl;
+	const uint64_t lo = t + (rm1 << 32);
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t __harbol_hash_mix(uint64_t a, uint64_t b)
+{
+	__harbol_hash_mum(&a, &b);
+	return a ^ b;
+}
+
+/* reads are little endian on every platform so hashes don't change with byte order. */
+static inline NO_NULL uint64_t __harbol_hash_read8(const uint8_t p[static 8])
+{
+	return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24
+		| (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 | (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline NO_NULL uint64_t __harbol_hash_read4(const uint8_t p[static 4])
+{
+	return (uint64_t)p[0] | (uint64_t)p[1] << 8 | (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24;
+}
+
+static inline NO_NULL uint64_t __harbol_hash_read3(const uint8_t p[static 1], const size_t k)
+{
+	return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+HARBOL_EXPORT uint64_t harbol_hash_bytes(const void *const key, const size_t len, uint64_t seed)
+{
+	const uint64_t *const s = __harbol_hash_secret;
+	const uint8_t *p = key;
+	uint64_t a = 0, b = 0;
+	seed ^= __harbol_hash_mix(seed ^ s[0], s[1]);
+	if( len <= 16 ) {
+		if( len >= 4 ) {
+			a = (__harbol_hash_read4(p) << 32) | __harbol_hash_read4(p + ((len >> 3) << 2));
+			b = (__harbol_hash_read4(p + len - 4) << 32) | __harbol_hash_read4(p + len - 4 - ((len >> 3) << 2));
+		} else if( len > 0 ) {
+			a = __harbol_hash_read3(p, len);
+		}
+	} else {
+		size_t i = len;
+		if( i > 48 ) {
+			uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = __harbol_hash_mix(__harbol_hash_read8(p) ^ s[1], __harbol_hash_read8(p + 8) ^ seed);
+				see1 = __harbol_hash_mix(__harbol_hash_read8(p + 16) ^ s[2], __harbol_hash_read8(p + 24) ^ see1);
+				see2 = __harbol_hash_mix(__harbol_hash_read8(p + 32) ^ s[3], __harbol_hash_read8(p + 40) ^ see2);
+				p += 48, i -= 48;
+			} while( i > 48 );
+			seed ^= see1 ^ see2;
+		}
+		while( i > 16 ) {
+			seed = __harbol_hash_mix(__harbol_hash_read8(p) ^ s[1], __harbol_hash_read8(p + 8) ^ seed);
+			p += 16, i -= 16;
+		}
+		a = __harbol_hash_read8(p + i - 16);
+		b = __harbol_hash_read8(p + i - 8);
+	}
+	a ^= s[1];
+	b ^= seed;
+	__harbol_hash_mum(&a, &b);
+	return __harbol_hash_mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+HARBOL_EXPORT uint64_t harbol_hash_cstr(const char cstr[restrict static 1], const uint64_t seed, size_t *const restrict len)
+{
+	/* strlen is already vectorized by libc so measuring first is cheaper than hashing byte by byte. */
+	const size_t n = strlen(cstr);
+	if( len != NULL )
+		*len = n;
+	return harbol_hash_bytes(cstr, n, seed);
+}
+
+HARBOL_EXPORT uint64_t harbol_hash_int(const uint64_t key, const uint64_t seed)
+{
+	return __harbol_hash_mix(key ^ __harbol_hash_secret[0], seed ^ __harbol_hash_secret[1]);
+}
+
+HARBOL_EXPORT uint64_t harbol_hash_seed(void)
+{
+	/* maps get created from many threads at once (every concmap shard seeds its own), so the bump has to be atomic. */
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+	static uint64_t counter = 0;
+	const uint64_t count = __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);
+#elif defined(COMPILER_MSVC)
+	static volatile int64_t counter = 0;
+	const uint64_t count = (uint64_t)_InterlockedIncrement64(&counter);
+#elif defined(C11) && !defined(__STDC_NO_ATOMICS__)
+	static _Atomic uint64_t counter = 0;
+	const uint64_t count = ++counter;
+#else
+	/* no atomics to use, racing threads can share a count but the stack address still differs. */
+	static uint64_t counter = 0;
+	const uint64_t count = ++counter;
+#endif
+	const uint64_t local = 0;
+	uint64_t seed = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+	seed = __harbol_hash_mix(seed ^ (uint64_t)(uintptr_t)&local, count ^ __harbol_hash_secret[2]);
+	return __harbol_hash_mix(seed ^ (uint64_t)(uintptr_t)&counter, __harbol_hash_secret[3]);
+}
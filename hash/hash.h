@@ -0,0 +1,28 @@
+#ifndef HARBOL_HASH_INCLUDED
+#	define HARBOL_HASH_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../harbol_common_defines.h"
+#include "../harbol_common_includes.h"
+
+/* wyhash-based, word-at-a-time seeded hashes.
+ * like the hashes in harbol_common_includes.h, these are NOT cryptographic hashes.
+ * the seed is what makes the output unpredictable to anyone trying to flood a table with colliding keys.
+ */
+HARBOL_EXPORT NEVER_NULL(1) uint64_t harbol_hash_bytes(const void *key, size_t len, uint64_t seed);
+HARBOL_EXPORT NEVER_NULL(1) uint64_t harbol_hash_cstr(const char cstr[], uint64_t seed, size_t *len);
+HARBOL_EXPORT uint64_t harbol_hash_int(uint64_t key, uint64_t seed);
+
+/* makes a new random-ish seed from the clock, addresses, and a counter. */
+HARBOL_EXPORT uint64_t harbol_hash_seed(void);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_HASH_INCLUDED */
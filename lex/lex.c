@@ -5,6 +5,13 @@
 #	define HARBOL_LIB
 #endif
 
+/* the number & string lexers take a NULL 'buf' to only validate a token, the '*_view' lexers rely on that. */
+static inline void __lex_add_char(struct HarbolString *const buf, const char c)
+{
+	if( buf != NULL )
+		harbol_string_add_char(buf, c);
+}
+
 
 HARBOL_EXPORT bool is_alphabetic(const int32_t c)
 {
@@ -146,7 +153,7 @@ HARBOL_EXPORT bool lex_single_line_comment(const char str[static 1], const char
 		harbol_string_add_char(buf, *str++);
 	}
 	*end = str;
-	return buf->len > 0;
+	return harbol_string_len(buf) > 0;
 }
 
 HARBOL_EXPORT bool lex_multi_line_comment(const char str[static 1], const char **const end, const char end_token[restrict static 1], const size_t end_len, struct HarbolString *const restrict buf)
@@ -159,7 +166,7 @@ HARBOL_EXPORT bool lex_multi_line_comment(const char str[static 1], const char *
 	if( *str != 0 )
 		str += end_len;
 	*end = str;
-	return buf->len > 0;
+	return harbol_string_len(buf) > 0;
 }
 
 
@@ -348,16 +355,16 @@ HARBOL_EXPORT bool lex_c_style_hex(const char str[static 1], const char **const
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_c_style_hex_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	if( *str != 'x' && *str != 'X' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_c_style_hex_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -376,66 +383,66 @@ HARBOL_EXPORT bool lex_c_style_hex(const char str[static 1], const char **const
 			case '.':
 				*is_float = true;
 				if( !(lit_flags & one_hex) ) { /// missing at least one hex number before float dot.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
 					lit_flags |= flt_dot;
 					lit_flags &= ~one_hex;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'P': case 'p':
 				*is_float = true;
 				if( (lit_flags & exponent_p) ) { /// too many P's.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
 					lit_flags |= exponent_p;
 					lit_flags &= ~one_hex;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '+': case '-':
 				if( !(lit_flags & (exponent_p|flt_dot)) ) { /// bad +/- placement.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else if( !is_decimal(str[1]) ) { /// no number after exponent?
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					lit_flags |= math_op;
 				}
 				break;
 			case 'U': case 'u':
 				if( lit_flags & uflag ) { /// too many U's.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else if( (lit_flags & long1) && (str[1]=='L'||str[1]=='l') ) { /// U between L's.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
 					lit_flags |= uflag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'L': case 'l':
 				if( lit_flags & long2 ) { /// too many L's.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
 					lit_flags |= ( (lit_flags & long1) ? long2 : long1 );
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'a': case 'b': case 'c': case 'd': case 'e': case 'f':
 			case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
 				if( (lit_flags & exponent_p) ) {
 					if( !(lit_flags & one_hex) ) { /// hex float exponent with no digits?
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						goto lex_c_style_hex_err;
 					} else if( (chr=='F'||chr=='f') ) { /// invalid hex float suffix!
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						if( lit_flags & f_suffix ) {
 							goto lex_c_style_hex_err;
 						} else {
@@ -443,17 +450,17 @@ HARBOL_EXPORT bool lex_c_style_hex(const char str[static 1], const char **const
 							break;
 						}
 					} else if( lit_flags & f_suffix ) { /// also bad hex float suffix.
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						goto lex_c_style_hex_err;
 					}
 				}
 				if( !(lit_flags & one_hex) )
 					lit_flags |= one_hex;
 				if( lit_flags & (uflag|long1|long2) ) { /// extraneous suffix on int hex?
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '0': case '1': case '2': case '3': case '4':
@@ -461,20 +468,20 @@ HARBOL_EXPORT bool lex_c_style_hex(const char str[static 1], const char **const
 				if( !(lit_flags & one_hex) )
 					lit_flags |= one_hex;
 				if( lit_flags & (uflag|long1|long2) ) { /// extraneous suffix on int hex?
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else if( lit_flags & f_suffix ) { /// bad hex float suffix.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			default:
 				if( chr <= -1 ) {
 					/// add foreign numbers.
 				} else { /// invalid hex digit/glyph.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_hex_err;
 				}
 				break;
@@ -499,16 +506,16 @@ HARBOL_EXPORT bool lex_go_style_hex(const char str[static 1], const char **const
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_hex_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	if( *str != 'x' && *str != 'X' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_hex_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -524,34 +531,34 @@ HARBOL_EXPORT bool lex_go_style_hex(const char str[static 1], const char **const
 			case '.':
 				*is_float = true;
 				if( (lit_flags & underscore_flag) || str[1]=='_' ) { /// underscore before or after dot.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_hex_err;
 				} else {
 					lit_flags |= flt_dot;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'P': case 'p':
 				*is_float = true;
 				if( !(lit_flags & one_hex) ) { /// missing at least one hex number before hex exponent.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_hex_err;
 				} else if( (lit_flags & underscore_flag) || str[1]=='_' ) { /// underscore before or after exponent.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_hex_err;
 				} else {
 					lit_flags |= exponent_p;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '+': case '-':
 				if( lit_flags & (exponent_p|flt_dot) ) {
 					if( !is_decimal(str[1]) ) { /// no number after exponent?
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						goto lex_go_style_hex_err;
 					} else {
 						lit_flags |= math_op;
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 					}
 				} else return true;
 				break;
@@ -561,20 +568,20 @@ HARBOL_EXPORT bool lex_go_style_hex(const char str[static 1], const char **const
 			case '5': case '6': case '7': case '8': case '9':
 				if( !(lit_flags & one_hex) )
 					lit_flags |= one_hex;
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				lit_flags &= ~underscore_flag;
 				break;
 			case '_':
 				if( lit_flags & underscore_flag ) { /// too many underscores.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_hex_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					lit_flags |= underscore_flag;
 				}
 				break;
 			default: /// invalid hex digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_go_style_hex_err;
 		}
 		str++;
@@ -597,10 +604,10 @@ HARBOL_EXPORT bool lex_c_style_octal(const char str[static 1], const char **cons
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_c_style_octal_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -615,36 +622,36 @@ HARBOL_EXPORT bool lex_c_style_octal(const char str[static 1], const char **cons
 				return lex_c_style_decimal(str, end, buf, is_float);
 			case 'U': case 'u':
 				if( lit_flags & uflag ) { /// too many Us.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_octal_err;
 				} else if( (lit_flags & long1) && (str[1]=='L'||str[1]=='l') ) { /// U in between Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_octal_err;
 				} else {
 					lit_flags |= uflag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'L': case 'l':
 				if( lit_flags & long2 ) { /// too many Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_octal_err;
 				} else {
 					lit_flags |= ( (lit_flags & long1) ? long2 : long1 );
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '0': case '1': case '2': case '3':
 			case '4': case '5': case '6': case '7':
 				if( lit_flags & (uflag|long1|long2) ) { /// add more digits after the int suffix...
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_octal_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_c_style_octal_err;
 				break;
 		}
@@ -663,16 +670,16 @@ HARBOL_EXPORT bool lex_go_style_octal(const char str[static 1], const char **con
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_octal_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	if( *str != 'o' && *str != 'O' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_octal_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -683,20 +690,20 @@ HARBOL_EXPORT bool lex_go_style_octal(const char str[static 1], const char **con
 		switch( chr ) {
 			case '_':
 				if( lit_flags & underscore_flag ) { /// too many underscores.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_octal_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					lit_flags |= underscore_flag;
 				}
 				break;
 			case '0': case '1': case '2': case '3':
 			case '4': case '5': case '6': case '7':
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				lit_flags &= ~underscore_flag;
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_go_style_octal_err;
 				break;
 		}
@@ -719,16 +726,16 @@ HARBOL_EXPORT bool lex_c_style_binary(const char str[static 1], const char **con
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_c_style_binary_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	if( *str != 'b' && *str != 'B' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_c_style_binary_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -741,35 +748,35 @@ HARBOL_EXPORT bool lex_c_style_binary(const char str[static 1], const char **con
 		switch( chr ) {
 			case 'U': case 'u':
 				if( lit_flags & uflag ) { /// too many Us.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_binary_err;
 				} else if( (lit_flags & long1) && (str[1]=='L'||str[1]=='l') ) { /// U in between Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_binary_err;
 				} else {
 					lit_flags |= uflag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'L': case 'l':
 				if( lit_flags & long2 ) { /// too many Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_binary_err;
 				} else {
 					lit_flags |= ( (lit_flags & long1) ? long2 : long1 );
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '0': case '1':
 				if( lit_flags & (uflag|long1|long2) ) { /// add more digits after the int suffix...
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_binary_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_c_style_binary_err;
 				break;
 		}
@@ -788,16 +795,16 @@ HARBOL_EXPORT bool lex_go_style_binary(const char str[static 1], const char **co
 	if( *str==0 )
 		return result;
 	else if( *str != '0' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_binary_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	if( *str != 'b' && *str != 'B' ) {
-		harbol_string_add_char(buf, *str++);
+		__lex_add_char(buf, *str++);
 		goto lex_go_style_binary_err;
 	}
-	else harbol_string_add_char(buf, *str++);
+	else __lex_add_char(buf, *str++);
 	
 	size_t lit_flags = 0;
 	const size_t
@@ -808,19 +815,19 @@ HARBOL_EXPORT bool lex_go_style_binary(const char str[static 1], const char **co
 		switch( chr ) {
 			case '_':
 				if( lit_flags & underscore_flag ) { /// too many underscores.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_binary_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					lit_flags |= underscore_flag;
 				}
 				break;
 			case '0': case '1':
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				lit_flags &= ~underscore_flag;
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_go_style_binary_err;
 				break;
 		}
@@ -858,78 +865,78 @@ HARBOL_EXPORT bool lex_c_style_decimal(const char str[static 1], const char **co
 		switch( chr ) {
 			case '.':
 				if( lit_flags & flt_dot ) { /// too many float dots.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
 					lit_flags |= flt_dot;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					*is_float = true;
 				}
 				break;
 			case '-': case '+':
 				if( lit_flags & (flt_e_flag|flt_dot) ) {
 					if( !is_decimal(str[1]) ) { /// no number after exponent?
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						goto lex_c_style_decimal_err;
 					} else {
 						lit_flags |= math_op;
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 					}
 				} else return true;
 				break;
 			case 'F': case 'f':
 				if( !(lit_flags & (flt_dot|flt_e_flag)) ) { /// missing dot or exponent.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( lit_flags & flt_f_flag ) { /// already have an F float suffix.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( (lit_flags & flt_e_flag) && !(lit_flags & got_exp_num) ) { /// f suffix but no exponent numbers.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
 					lit_flags |= flt_f_flag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'E': case 'e':
 				if( lit_flags & flt_e_flag ) { /// too many Es.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( lit_flags & flt_f_flag ) { /// bad float suffix. E should be before F.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
 					lit_flags |= flt_e_flag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					*is_float = true;
 				}
 				break;
 			case 'U': case 'u':
 				if( lit_flags & uflag ) { /// too manu Us.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( (lit_flags & long1) && (str[1]=='L'||str[1]=='l') ) { /// U in between Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( lit_flags & (flt_dot|flt_f_flag|flt_e_flag) ) { /// int suffix on float literal.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
 					lit_flags |= uflag;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case 'L': case 'l':
 				if( lit_flags & long2 ) { /// too many Ls.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( lit_flags & (flt_dot|flt_f_flag|flt_e_flag) ) { /// int suffix on float literal.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
 					lit_flags |= ( (lit_flags & long1) ? long2 : long1 );
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '0': case '1': case '2': case '3': case '4':
@@ -937,17 +944,17 @@ HARBOL_EXPORT bool lex_c_style_decimal(const char str[static 1], const char **co
 				if( lit_flags & flt_e_flag )
 					lit_flags |= got_exp_num;
 				if( lit_flags & (uflag|long1|long2) ) { /// numbers after int suffix.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else if( lit_flags & flt_f_flag ) { /// numbers after float suffix.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_c_style_decimal_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_c_style_decimal_err;
 				break;
 		}
@@ -983,60 +990,60 @@ HARBOL_EXPORT bool lex_go_style_decimal(const char str[static 1], const char **c
 			case '.':
 				*is_float = true;
 				if( lit_flags & flt_dot ) { /// too many float dots.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_decimal_err;
 				} else if( (lit_flags & underscore_flag) || str[1]=='_' ) { /// underscore before or after dot.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_decimal_err;
 				} else {
 					lit_flags |= flt_dot;
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 				}
 				break;
 			case '-': case '+':
 				if( lit_flags & (flt_e_flag|flt_dot) ) {
 					if( !is_decimal(str[1]) ) { /// no number after exponent?
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 						goto lex_go_style_decimal_err;
 					} else {
 						lit_flags |= math_op;
-						harbol_string_add_char(buf, chr);
+						__lex_add_char(buf, chr);
 					}
 				} else return true;
 				break;
 			case 'E': case 'e':
 				*is_float = true;
 				if( lit_flags & flt_e_flag ) { /// too many Es.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_decimal_err;
 				} else if( (lit_flags & underscore_flag) || str[1]=='_' ) { /// not separating numbers.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_decimal_err;
 				} else {
 					lit_flags |= flt_e_flag;
-					harbol_string_add_char(buf, chr);
-					
+					__lex_add_char(buf, chr);
+				
 				}
 				break;
 			case '0': case '1': case '2': case '3': case '4':
 			case '5': case '6': case '7': case '8': case '9':
 				if( lit_flags & flt_e_flag )
 					lit_flags |= got_exp_num;
-				
-				harbol_string_add_char(buf, chr);
+			
+				__lex_add_char(buf, chr);
 				lit_flags &= ~underscore_flag;
 				break;
 			case '_':
 				if( lit_flags & underscore_flag ) { /// too many underscores.
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					goto lex_go_style_decimal_err;
 				} else {
-					harbol_string_add_char(buf, chr);
+					__lex_add_char(buf, chr);
 					lit_flags |= underscore_flag;
 				}
 				break;
 			default: /// bad digit/glyph.
-				harbol_string_add_char(buf, chr);
+				__lex_add_char(buf, chr);
 				goto lex_go_style_decimal_err;
 				break;
 		}
@@ -1062,7 +1069,7 @@ HARBOL_EXPORT bool lex_c_style_number(const char str[static 1], const char **con
 				case 'x': case 'X': return lex_c_style_hex(str, end, buf, is_float);
 				case 'b': case 'B': return lex_c_style_binary(str, end, buf);
 				case '.':           return lex_c_style_decimal(str, end, buf, is_float);
-				default:            return lex_c_style_octal(str, end, buf);
+				default:            return lex_c_style_octal(str, end, buf, is_float);
 			}
 		}
 		case '.': case '1': case '2': case '3': case '4':
@@ -1102,25 +1109,25 @@ static bool _lex_str(const char str[static 1], const char **const end, struct Ha
 		} else if( c=='\\' ) {
 			const char esc = *++str;
 			if( raw ) {
-				harbol_string_add_char(buf, c);
-				harbol_string_add_char(buf, esc);
+				__lex_add_char(buf, c);
+				__lex_add_char(buf, esc);
 			} else {
 				switch( esc ) {
-					case 'a': harbol_string_add_char(buf, '\a'); break;
-					case 'r': harbol_string_add_char(buf, '\r'); break;
-					case 'b': harbol_string_add_char(buf, '\b'); break;
-					case 't': harbol_string_add_char(buf, '\t'); break;
-					case 'v': harbol_string_add_char(buf, '\v'); break;
-					case 'n': harbol_string_add_char(buf, '\n'); break;
-					case 'N': harbol_string_add_char(buf, '\n'); break;
-					case 'f': harbol_string_add_char(buf, '\f'); break;
-					case 'e': harbol_string_add_char(buf, 0x1B); break;  /// '\e' is GNU extension
+					case 'a': __lex_add_char(buf, '\a'); break;
+					case 'r': __lex_add_char(buf, '\r'); break;
+					case 'b': __lex_add_char(buf, '\b'); break;
+					case 't': __lex_add_char(buf, '\t'); break;
+					case 'v': __lex_add_char(buf, '\v'); break;
+					case 'n': __lex_add_char(buf, '\n'); break;
+					case 'N': __lex_add_char(buf, '\n'); break;
+					case 'f': __lex_add_char(buf, '\f'); break;
+					case 'e': __lex_add_char(buf, 0x1B); break;  /// '\e' is GNU extension
 					case 'x': case 'X': {
 						str++;
 						const int32_t h = lex_hex_escape_char(str, &str);
 						if( h == -1 )
 							goto lex_str_err;
-						else write_utf8_str(buf, h);
+						else if( buf != NULL ) write_utf8_str(buf, h);
 						str--;
 						break;
 					}
@@ -1129,7 +1136,7 @@ static bool _lex_str(const char str[static 1], const char **const end, struct Ha
 						const int32_t h = lex_octal_escape_char(str, &str);
 						if( h == -1 )
 							goto lex_str_err;
-						else write_utf8_str(buf, h);
+						else if( buf != NULL ) write_utf8_str(buf, h);
 						str--;
 						break;
 					}
@@ -1138,14 +1145,14 @@ static bool _lex_str(const char str[static 1], const char **const end, struct Ha
 						const int32_t h = lex_unicode_char(str, &str, esc=='u' ? sizeof(int16_t) : sizeof(int32_t));
 						if( h == -1 )
 							goto lex_str_err;
-						else write_utf8_str(buf, h);
+						else if( buf != NULL ) write_utf8_str(buf, h);
 						str--;
 						break;
 					}
-					default: harbol_string_add_char(buf, esc);
+					default: __lex_add_char(buf, esc);
 				}
 			}
-		} else harbol_string_add_char(buf, c);
+		} else __lex_add_char(buf, c);
 	}
 	str++;
 	result = true;
@@ -1163,3 +1170,37 @@ HARBOL_EXPORT bool lex_go_style_str(const char str[static 1], const char **const
 {
 	return _lex_str(str, end, buf, *str=='`');
 }
+
+HARBOL_EXPORT bool lex_c_style_number_view(const char str[static 1], const char **const end, struct HarbolStrView *const restrict view, bool *const restrict is_float)
+{
+	*end = str;
+	const bool result = lex_c_style_number(str, end, NULL, is_float);
+	*view = (struct HarbolStrView){ str, (size_t)(*end - str) };
+	return result;
+}
+
+HARBOL_EXPORT bool lex_go_style_number_view(const char str[static 1], const char **const end, struct HarbolStrView *const restrict view, bool *const restrict is_float)
+{
+	*end = str;
+	const bool result = lex_go_style_number(str, end, NULL, is_float);
+	*view = (struct HarbolStrView){ str, (size_t)(*end - str) };
+	return result;
+}
+
+static bool _lex_str_view(const char str[static 1], const char **const end, struct HarbolStrView *const restrict view, const bool raw)
+{
+	const bool result = _lex_str(str, end, NULL, raw);
+	/* the view skips the quotes but leaves any escapes as they're written. */
+	*view = (struct HarbolStrView){ str + 1, (size_t)(*end - str) - (result ? 2 : 1) };
+	return result;
+}
+
+HARBOL_EXPORT bool lex_c_style_str_view(const char str[static 1], const char **const end, struct HarbolStrView *const restrict view)
+{
+	return _lex_str_view(str, end, view, false);
+}
+
+HARBOL_EXPORT bool lex_go_style_str_view(const char str[static 1], const char **const end, struct HarbolStrView *const restrict view)
+{
+	return _lex_str_view(str, end, view, *str=='`');
+}
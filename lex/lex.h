@@ -39,23 +39,30 @@ HARBOL_EXPORT NO_NULL int32_t lex_hex_escape_char(const char str[], const char *
 HARBOL_EXPORT NO_NULL int32_t lex_octal_escape_char(const char str[], const char **end);
 HARBOL_EXPORT NO_NULL int32_t lex_unicode_char(const char str[], const char **end, const size_t encoding);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_hex(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
-HARBOL_EXPORT NO_NULL bool lex_go_style_hex(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+/* a NULL 'buf' only validates the token without copying it out. */
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_c_style_hex(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_go_style_hex(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_octal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
-HARBOL_EXPORT NO_NULL bool lex_go_style_octal(const char str[], const char **end, struct HarbolString *buf);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_c_style_octal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool lex_go_style_octal(const char str[], const char **end, struct HarbolString *buf);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_binary(const char str[], const char **end, struct HarbolString *buf);
-HARBOL_EXPORT NO_NULL bool lex_go_style_binary(const char str[], const char **end, struct HarbolString *buf);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool lex_c_style_binary(const char str[], const char **end, struct HarbolString *buf);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool lex_go_style_binary(const char str[], const char **end, struct HarbolString *buf);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_decimal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
-HARBOL_EXPORT NO_NULL bool lex_go_style_decimal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_c_style_decimal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_go_style_decimal(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_number(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
-HARBOL_EXPORT NO_NULL bool lex_go_style_number(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_c_style_number(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
+HARBOL_EXPORT NEVER_NULL(1, 2, 4) bool lex_go_style_number(const char str[], const char **end, struct HarbolString *buf, bool *is_float);
 
-HARBOL_EXPORT NO_NULL bool lex_c_style_str(const char str[], const char **end, struct HarbolString *buf);
-HARBOL_EXPORT NO_NULL bool lex_go_style_str(const char str[], const char **end, struct HarbolString *buf);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool lex_c_style_str(const char str[], const char **end, struct HarbolString *buf);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool lex_go_style_str(const char str[], const char **end, struct HarbolString *buf);
+
+/* zero-copy versions, 'view' points into 'str'. string views leave out the quotes and keep escapes undecoded. */
+HARBOL_EXPORT NO_NULL bool lex_c_style_number_view(const char str[], const char **end, struct HarbolStrView *view, bool *is_float);
+HARBOL_EXPORT NO_NULL bool lex_go_style_number_view(const char str[], const char **end, struct HarbolStrView *view, bool *is_float);
+HARBOL_EXPORT NO_NULL bool lex_c_style_str_view(const char str[], const char **end, struct HarbolStrView *view);
+HARBOL_EXPORT NO_NULL bool lex_go_style_str_view(const char str[], const char **end, struct HarbolStrView *view);
 /********************************************************************/
 
 #ifdef __cplusplus
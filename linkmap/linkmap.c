@@ -1,10 +1,263 @@
 #include "linkmap.h"
+#include "../map/map_group.h"
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
 #endif
 
 
+static inline struct HarbolKeyVal **__harbol_linkmap_entries(const struct HarbolLinkMap *const map)
+{
+	return (struct HarbolKeyVal **)map->vec.table;
+}
+
+/* compacting only once the holes are a fair share of the live pairs pays for the rebuild. */
+static inline size_t __harbol_linkmap_max_holes(const size_t count)
+{
+	return 8 + (count >> 2);
+}
+
+static inline size_t __harbol_linkmap_lowbit(const size_t n)
+{
+	return n & (~n + 1);
+}
+
+/* (re)builds the hole tree to cover 'holes_len' positions straight from the entries, linear in 'holes_len'.
+ * 'holes[n]' is fenwick node 'n + 1', it counts the holes in positions '(n + 1 - lowbit(n + 1), n]'.
+ */
+static NO_NULL bool __harbol_linkmap_build_holes(struct HarbolLinkMap *const map, const size_t holes_len)
+{
+	uint32_t *const holes = ( map->holes==NULL ) ? harbol_alloc(holes_len, sizeof *holes) : harbol_realloc(map->holes, holes_len * sizeof *holes);
+	if( holes==NULL )
+		return false;
+	
+	map->holes = holes;
+	map->holes_len = holes_len;
+	struct HarbolKeyVal *const *const entries = __harbol_linkmap_entries(map);
+	for( uindex_t i=0; i<holes_len; i++ )
+		holes[i] = i < map->vec.count && entries[i]==NULL;
+	for( uindex_t i=1; i<=holes_len; i++ ) {
+		const size_t parent = i + __harbol_linkmap_lowbit(i);
+		if( parent <= holes_len )
+			holes[parent - 1] += holes[i - 1];
+	}
+	return true;
+}
+
+static NO_NULL void __harbol_linkmap_mark_hole(struct HarbolLinkMap *const map, const size_t pos, const int32_t delta)
+{
+	for( size_t i=pos + 1; i <= map->holes_len; i += __harbol_linkmap_lowbit(i) )
+		map->holes[i - 1] += delta;
+	map->hole_count += delta;
+}
+
+/* number of holes before position 'pos' in the entries. */
+static NO_NULL size_t __harbol_linkmap_holes_before(const struct HarbolLinkMap *const map, const size_t pos)
+{
+	size_t holes = 0;
+	if( map->hole_count > 0 )
+		for( size_t i=pos; i>0; i &= i - 1 )
+			holes += map->holes[i - 1];
+	return holes;
+}
+
+/* probes the index for either a key or, if 'findkv' is given, that exact pair.
+ * returns the index slot or -1, 'free_slot' works the same as in 'HarbolMap'.
+ */
+static NEVER_NULL(1) index_t __harbol_linkmap_probe(const struct HarbolLinkMap *const restrict map, const char key[const], const size_t keylen, const struct HarbolKeyVal *const findkv, const size_t hash, index_t *const restrict free_slot)
+{
+	if( free_slot != NULL )
+		*free_slot = -1;
+	if( map->index==NULL )
+		return -1;
+	
+	struct HarbolKeyVal *const *const entries = __harbol_linkmap_entries(map);
+	const uint8_t h2 = hash & 0x7F;
+	const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	for( size_t step=0; step<=group_mask; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		for( uint64_t match = __harbol_map_group_match(&map->ctrl[base], h2); match != 0; match &= match - 1 ) {
+			const size_t slot = base + __harbol_map_lowest_bit(match);
+			const struct HarbolKeyVal *const kv = entries[map->index[slot]];
+			if( findkv != NULL ) {
+				if( kv==findkv )
+					return slot;
+			} else if( kv->hash==hash && harbol_string_len(&kv->key)==keylen && !memcmp(harbol_string_cstr(&kv->key), key, keylen) ) {
+				return slot;
+			}
+		}
+		if( free_slot != NULL && *free_slot<0 ) {
+			const uint64_t open = __harbol_map_group_match_free(&map->ctrl[base]);
+			if( open != 0 )
+				*free_slot = base + __harbol_map_lowest_bit(open);
+		}
+		if( __harbol_map_group_match_empty(&map->ctrl[base]) )
+			return -1;
+		group = (group + step + 1) & group_mask;
+	}
+	return -1;
+}
+
+static inline NO_NULL index_t __harbol_linkmap_find(const struct HarbolLinkMap *const restrict map, const char key[restrict static 1])
+{
+	size_t keylen = 0;
+	const size_t hash = (size_t)harbol_hash_cstr(key, map->seed, &keylen);
+	return __harbol_linkmap_probe(map, key, keylen, NULL, hash, NULL);
+}
+
+static inline NO_NULL index_t __harbol_linkmap_find_view(const struct HarbolLinkMap *const restrict map, const struct HarbolStrView key)
+{
+	return( key.ptr==NULL ) ? -1 : __harbol_linkmap_probe(map, key.ptr, key.len, NULL, (size_t)harbol_hash_bytes(key.ptr, key.len, map->seed), NULL);
+}
+
+static NO_NULL size_t __harbol_linkmap_find_free(const struct HarbolLinkMap *const map, const size_t hash)
+{
+	const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	for( size_t step=0; ; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		const uint64_t match = __harbol_map_group_match_free(&map->ctrl[base]);
+		if( match != 0 )
+			return base + __harbol_map_lowest_bit(match);
+		group = (group + step + 1) & group_mask;
+	}
+}
+
+/* squeezes the holes out of the entries and rebuilds the index at 'new_len' slots, or less if that's enough.
+ * pairs cache their hashes so this never touches the key bytes.
+ */
+static NO_NULL bool __harbol_linkmap_rebuild(struct HarbolLinkMap *const map, const size_t new_len)
+{
+	const size_t len = __harbol_map_table_len(new_len, map->count);
+	uint32_t *const index = harbol_alloc(len, sizeof *index + sizeof(uint8_t));
+	if( index==NULL )
+		return false;
+	
+	harbol_free(map->index);
+	map->index = index;
+	map->ctrl = (uint8_t *)&index[len];
+	memset(map->ctrl, HarbolMapCtrl_Empty, len);
+	map->len = len;
+	map->tombs = 0;
+	
+	struct HarbolKeyVal **const entries = __harbol_linkmap_entries(map);
+	size_t live = 0;
+	for( uindex_t i=0; i<map->vec.count; i++ ) {
+		if( entries[i]==NULL )
+			continue;
+		entries[live] = entries[i];
+		const size_t slot = __harbol_linkmap_find_free(map, entries[live]->hash);
+		map->ctrl[slot] = entries[live]->hash & 0x7F;
+		map->index[slot] = live++;
+	}
+	map->vec.count = live;
+	
+	/* no holes left to count, the tree gets built again for the next one. */
+	harbol_free(map->holes), map->holes=NULL;
+	map->holes_len = map->hole_count = 0;
+	return true;
+}
+
+/* appends a pair that's known not to be in the map yet, 'free_slot' is from the probe that checked that. */
+static NO_NULL bool __harbol_linkmap_append(struct HarbolLinkMap *const map, struct HarbolKeyVal *kv, const size_t hash, index_t free_slot)
+{
+	if( map->vec.count >= UINT32_MAX )
+		return false;
+	
+	if( map->len==0 || map->count + map->tombs >= __harbol_map_max_load(map->len) ) {
+		const size_t new_len = (map->len==0) ? MAP_DEFAULT_SIZE : (map->count >= (map->len >> 1)) ? map->len << 1 : map->len;
+		if( !__harbol_linkmap_rebuild(map, new_len) )
+			return false;
+		free_slot = -1;
+	}
+	/* the hole tree has to cover the new position too. */
+	if( map->holes != NULL && map->vec.count >= map->holes_len && !__harbol_linkmap_build_holes(map, harbol_grow_len(map->holes_len, map->vec.count + 1)) )
+		return false;
+	if( !harbol_vector_insert(&map->vec, &kv) )
+		return false;
+	
+	if( free_slot<0 )
+		free_slot = __harbol_linkmap_find_free(map, hash);
+	if( map->ctrl[free_slot]==HarbolMapCtrl_Deleted )
+		map->tombs--;
+	kv->hash = hash;
+	map->ctrl[free_slot] = hash & 0x7F;
+	map->index[free_slot] = map->vec.count - 1;
+	map->count++;
+	return true;
+}
+
+/* maps an insertion order index to its position in 'vec'.
+ * walks down the hole tree for the last position with at most 'index' live pairs before it, that position is the pair itself.
+ */
+static NO_NULL index_t __harbol_linkmap_pos(const struct HarbolLinkMap *const map, const uindex_t index)
+{
+	if( index >= map->count )
+		return -1;
+	else if( map->hole_count==0 )
+		return index;
+	else {
+		size_t top = 1;
+		while( (top << 1) <= map->holes_len )
+			top <<= 1;
+		
+		size_t pos = 0, left = index;
+		for( size_t step=top; step>0; step >>= 1 ) {
+			if( pos + step > map->holes_len )
+				continue;
+			const size_t live = step - map->holes[pos + step - 1];
+			if( live <= left ) {
+				pos += step;
+				left -= live;
+			}
+		}
+		return pos;
+	}
+}
+
+/* inverse of '__harbol_linkmap_pos'. */
+static inline NO_NULL index_t __harbol_linkmap_index_of_pos(const struct HarbolLinkMap *const map, const size_t pos)
+{
+	return pos - __harbol_linkmap_holes_before(map, pos);
+}
+
+static NEVER_NULL(1) bool __harbol_linkmap_del_slot(struct HarbolLinkMap *const map, const size_t slot, void dtor(void**))
+{
+	struct HarbolKeyVal **const entries = __harbol_linkmap_entries(map);
+	const size_t pos = map->index[slot];
+	const bool newest = pos + 1==map->vec.count;
+	
+	/* the first hole needs a tree to count it in, build that before anything gets freed. */
+	if( !newest && map->holes==NULL && !__harbol_linkmap_build_holes(map, map->vec.count) )
+		return false;
+	harbol_kvpair_free(&entries[pos], dtor);
+	
+	/* deleting the newest pair doesn't leave a hole, it also frees up any holes right behind it. */
+	if( newest ) {
+		map->vec.count--;
+		while( map->vec.count > 0 && entries[map->vec.count - 1]==NULL )
+			__harbol_linkmap_mark_hole(map, --map->vec.count, -1);
+	} else {
+		__harbol_linkmap_mark_hole(map, pos, 1);
+	}
+	
+	const size_t base = slot & ~(size_t)(HARBOL_MAP_GROUP_WIDTH - 1);
+	if( __harbol_map_group_match_empty(&map->ctrl[base]) ) {
+		map->ctrl[slot] = HarbolMapCtrl_Empty;
+	} else {
+		map->ctrl[slot] = HarbolMapCtrl_Deleted;
+		map->tombs++;
+	}
+	map->count--;
+	
+	/* the rebuild also shrinks the index to fit, a failed one just leaves the holes for later. */
+	if( map->hole_count > __harbol_linkmap_max_holes(map->count) )
+		__harbol_linkmap_rebuild(map, 0);
+	return true;
+}
+
+
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new(const size_t datasize)
 {
 	struct HarbolLinkMap *map = harbol_alloc(1, sizeof *map);
@@ -15,14 +268,26 @@ HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new(const size_t datasize)
 
 HARBOL_EXPORT struct HarbolLinkMap harbol_linkmap_create(const size_t datasize)
 {
-	struct HarbolLinkMap map = { harbol_map_create(datasize), harbol_vector_create(sizeof(struct HarbolKeyVal *), MAP_DEFAULT_SIZE)};
+	struct HarbolLinkMap map = {
+		.vec = harbol_vector_create(sizeof(struct HarbolKeyVal *), MAP_DEFAULT_SIZE),
+		.datasize = datasize,
+		.seed = harbol_hash_seed()
+	};
 	return map;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_clear(struct HarbolLinkMap *const map, void dtor(void**))
 {
-	harbol_map_clear(&map->map, dtor);
+	struct HarbolKeyVal **const entries = __harbol_linkmap_entries(map);
+	for( uindex_t i=0; i<map->vec.count; i++ )
+		if( entries[i] != NULL )
+			harbol_kvpair_free(&entries[i], dtor);
 	harbol_vector_clear(&map->vec, NULL);
+	harbol_free(map->holes), map->holes=NULL;
+	harbol_free(map->index), map->index=NULL;
+	map->ctrl = NULL;
+	map->len = map->count = map->tombs = 0;
+	map->holes_len = map->hole_count = 0;
 	return true;
 }
 
@@ -35,113 +300,141 @@ HARBOL_EXPORT bool harbol_linkmap_free(struct HarbolLinkMap **const mapref, void
 
 HARBOL_EXPORT size_t harbol_linkmap_count(const struct HarbolLinkMap *const map)
 {
-	return map->vec.count;
+	return map->count;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_has_key(const struct HarbolLinkMap *const restrict map, const char key[restrict static 1])
 {
-	return harbol_map_has_key(&map->map, key);
+	return __harbol_linkmap_find(map, key) >= 0;
+}
+
+HARBOL_EXPORT bool harbol_linkmap_has_key_view(const struct HarbolLinkMap *const map, const struct HarbolStrView key)
+{
+	return __harbol_linkmap_find_view(map, key) >= 0;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_insert(struct HarbolLinkMap *const restrict map, const char key[restrict static 1], void *const restrict val)
 {
-	harbol_map_insert(&map->map, key, val);
-	struct HarbolKeyVal *kv = harbol_map_get_kv(&map->map, key);
-	harbol_vector_insert(&map->vec, &kv);
+	if( map->datasize==0 )
+		return false;
+	
+	size_t keylen = 0;
+	const size_t hash = (size_t)harbol_hash_cstr(key, map->seed, &keylen);
+	index_t free_slot = -1;
+	if( __harbol_linkmap_probe(map, key, keylen, NULL, hash, &free_slot) >= 0 )
+		return false;
+	
+	struct HarbolKeyVal *kv = harbol_kvpair_new(key, val, map->datasize);
+	if( kv==NULL )
+		return false;
+	else if( !__harbol_linkmap_append(map, kv, hash, free_slot) ) {
+		harbol_kvpair_free(&kv, NULL);
+		return false;
+	}
 	return true;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_insert_kv(struct HarbolLinkMap *const map, struct HarbolKeyVal *kv)
 {
-	harbol_map_insert_kv(&map->map, kv);
-	harbol_vector_insert(&map->vec, &kv);
-	return true;
+	size_t keylen = 0;
+	const size_t hash = (size_t)harbol_hash_cstr(harbol_string_cstr(&kv->key), map->seed, &keylen);
+	index_t free_slot = -1;
+	if( __harbol_linkmap_probe(map, harbol_string_cstr(&kv->key), keylen, NULL, hash, &free_slot) >= 0 )
+		return false;
+	return __harbol_linkmap_append(map, kv, hash, free_slot);
 }
 
 
 HARBOL_EXPORT void *harbol_linkmap_key_get(const struct HarbolLinkMap *const restrict map, const char key[restrict static 1])
 {
-	return harbol_map_get(&map->map, key);
+	struct HarbolKeyVal *const kv = harbol_linkmap_key_get_kv(map, key);
+	return( kv==NULL ) ? NULL : kv->data;
 }
 
 HARBOL_EXPORT void *harbol_linkmap_index_get(const struct HarbolLinkMap *const map, const uindex_t index)
 {
-	struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, index);
-	return( kv==NULL ) ? NULL : (*kv)->data;
+	struct HarbolKeyVal *const kv = harbol_linkmap_index_get_kv(map, index);
+	return( kv==NULL ) ? NULL : kv->data;
 }
 
 
 HARBOL_EXPORT struct HarbolKeyVal *harbol_linkmap_key_get_kv(const struct HarbolLinkMap *const map, const char key[restrict static 1])
 {
-	return harbol_map_get_kv(&map->map, key);
+	const index_t slot = __harbol_linkmap_find(map, key);
+	return( slot<0 ) ? NULL : __harbol_linkmap_entries(map)[map->index[slot]];
+}
+
+HARBOL_EXPORT void *harbol_linkmap_key_get_view(const struct HarbolLinkMap *const map, const struct HarbolStrView key)
+{
+	struct HarbolKeyVal *const kv = harbol_linkmap_key_get_kv_view(map, key);
+	return( kv==NULL ) ? NULL : kv->data;
+}
+
+HARBOL_EXPORT struct HarbolKeyVal *harbol_linkmap_key_get_kv_view(const struct HarbolLinkMap *const map, const struct HarbolStrView key)
+{
+	const index_t slot = __harbol_linkmap_find_view(map, key);
+	return( slot<0 ) ? NULL : __harbol_linkmap_entries(map)[map->index[slot]];
 }
 
 HARBOL_EXPORT struct HarbolKeyVal *harbol_linkmap_index_get_kv(const struct HarbolLinkMap *const map, const uindex_t index)
 {
-	struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, index);
-	return( kv==NULL ) ? NULL : *kv;
+	const index_t pos = __harbol_linkmap_pos(map, index);
+	return( pos<0 ) ? NULL : __harbol_linkmap_entries(map)[pos];
 }
 
 
 HARBOL_EXPORT bool harbol_linkmap_key_set(struct HarbolLinkMap *const map, const char key[restrict static 1], void *const restrict val)
 {
-	return harbol_map_set(&map->map, key, val);
+	struct HarbolKeyVal *const kv = harbol_linkmap_key_get_kv(map, key);
+	if( kv==NULL )
+		return harbol_linkmap_insert(map, key, val);
+	return( map->datasize==0 ) ? false : memcpy(kv->data, val, map->datasize) != NULL;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_index_set(struct HarbolLinkMap *const map, const uindex_t index, void *const restrict val)
 {
-	struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, index);
-	return( kv==NULL || map->map.datasize==0 ) ? false : memcpy((*kv)->data, val, map->map.datasize) != NULL;
+	struct HarbolKeyVal *const kv = harbol_linkmap_index_get_kv(map, index);
+	return( kv==NULL || map->datasize==0 ) ? false : memcpy(kv->data, val, map->datasize) != NULL;
 }
 
 HARBOL_EXPORT bool harbol_linkmap_key_del(struct HarbolLinkMap *const map, const char key[restrict static 1], void dtor(void**))
 {
-	struct HarbolKeyVal *kv = harbol_map_get_kv(&map->map, key);
-	harbol_map_del(&map->map, key, dtor);
-	harbol_vector_del(&map->vec, harbol_vector_index_of(&map->vec, &kv, 0), NULL);
-	return true;
+	const index_t slot = __harbol_linkmap_find(map, key);
+	return( slot<0 ) ? false : __harbol_linkmap_del_slot(map, slot, dtor);
 }
 
 HARBOL_EXPORT bool harbol_linkmap_index_del(struct HarbolLinkMap *const map, const uindex_t index, void dtor(void**))
 {
-	struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, index);
-	if( !kv )
-		return false;
-	else {
-		harbol_map_del(&map->map, (*kv)->key.cstr, dtor);
-		harbol_vector_del(&map->vec, index, NULL);
-		return true;
-	}
+	struct HarbolKeyVal *const kv = harbol_linkmap_index_get_kv(map, index);
+	return( kv==NULL ) ? false : __harbol_linkmap_del_slot(map, __harbol_linkmap_probe(map, NULL, 0, kv, kv->hash, NULL), dtor);
 }
 
 HARBOL_EXPORT index_t harbol_linkmap_get_key_index(const struct HarbolLinkMap *const map, const char key[restrict static 1])
 {
-	if( map->vec.datasize==0 )
-		return -1;
-	else {
-		for( uindex_t i=0; i<map->vec.count; i++ ) {
-			struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) )
-				return i;
-		}
-		return -1;
-	}
+	const index_t slot = __harbol_linkmap_find(map, key);
+	return( slot<0 ) ? -1 : __harbol_linkmap_index_of_pos(map, map->index[slot]);
 }
 
 HARBOL_EXPORT index_t harbol_linkmap_get_node_index(const struct HarbolLinkMap *const map, struct HarbolKeyVal *findkv)
 {
-	return harbol_vector_index_of(&map->vec, &findkv, 0);
+	/* the pair's cached hash is only meaningful if it belongs to this map, the pointer compare sorts that out. */
+	const index_t slot = __harbol_linkmap_probe(map, NULL, 0, findkv, findkv->hash, NULL);
+	return( slot<0 ) ? -1 : __harbol_linkmap_index_of_pos(map, map->index[slot]);
 }
 
 HARBOL_EXPORT index_t harbol_linkmap_get_val_index(const struct HarbolLinkMap *const map, void *const restrict val)
 {
-	if( map->map.datasize==0 )
+	if( map->datasize==0 )
 		return -1;
 	else {
+		struct HarbolKeyVal *const *const entries = __harbol_linkmap_entries(map);
+		size_t live = 0;
 		for( uindex_t i=0; i<map->vec.count; i++ ) {
-			struct HarbolKeyVal **kv = harbol_vector_get(&map->vec, i);
-			if( !memcmp((*kv)->data, val, map->map.datasize) )
-				return i;
+			if( entries[i]==NULL )
+				continue;
+			else if( !memcmp(entries[i]->data, val, map->datasize) )
+				return live;
+			live++;
 		}
 		return -1;
 	}
@@ -10,20 +10,31 @@ extern "C" {
 #include "../map/map.h"
 
 
+/* compact ordered dict: a small hash index of positions into a dense array of pairs kept in insertion order.
+ * deleting leaves a NULL hole in 'vec' that's squeezed out once the holes pile up,
+ * so iterating 'vec' directly has to skip NULL entries. indices given to the api never count holes.
+ */
 struct HarbolLinkMap {
-	struct HarbolMap map;
-	struct HarbolVector vec;
+	struct HarbolVector vec;   // dense 'struct HarbolKeyVal*' entries.
+	uint32_t *holes;           // fenwick tree counting the holes in 'vec', an entry's index is its position minus the holes before it.
+	uint32_t *index;           // positions into 'vec', probed like 'HarbolMap'. 'ctrl' is allocated right after it.
+	uint8_t *ctrl;
+	size_t len, count, tombs, datasize;
+	size_t holes_len, hole_count; // positions the 'holes' tree covers & how many holes are in 'vec'.
+	uint64_t seed;
 };
 
-#define EMPTY_HARBOL_LINKMAP    { EMPTY_HARBOL_VECTOR, EMPTY_HARBOL_MAP }
+#define EMPTY_HARBOL_LINKMAP    { EMPTY_HARBOL_VECTOR, NULL, NULL, NULL, 0, 0, 0, 0, 0, 0, 0 }
 
 HARBOL_EXPORT struct HarbolLinkMap *harbol_linkmap_new(size_t datasize);
 HARBOL_EXPORT struct HarbolLinkMap harbol_linkmap_create(size_t datasize);
+/* 'dtor' follows 'harbol_kvpair_free': it gets a pointer to a temporary copy of the pair's data pointer and must not free '*p' itself. */
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_linkmap_clear(struct HarbolLinkMap *map, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_linkmap_free(struct HarbolLinkMap **mapref, void dtor(void**));
 
 HARBOL_EXPORT NO_NULL size_t harbol_linkmap_count(const struct HarbolLinkMap *map);
 HARBOL_EXPORT NO_NULL bool harbol_linkmap_has_key(const struct HarbolLinkMap *map, const char key[]);
+HARBOL_EXPORT NO_NULL bool harbol_linkmap_has_key_view(const struct HarbolLinkMap *map, struct HarbolStrView key);
 
 HARBOL_EXPORT NO_NULL bool harbol_linkmap_insert(struct HarbolLinkMap *map, const char key[], void *val);
 HARBOL_EXPORT NO_NULL bool harbol_linkmap_insert_kv(struct HarbolLinkMap *map, struct HarbolKeyVal *kv);
@@ -34,9 +45,14 @@ HARBOL_EXPORT NO_NULL void *harbol_linkmap_index_get(const struct HarbolLinkMap
 HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_linkmap_key_get_kv(const struct HarbolLinkMap *map, const char key[]);
 HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_linkmap_index_get_kv(const struct HarbolLinkMap *map, uindex_t index);
 
+/* same as the 'key' getters but the key doesn't have to be null terminated. */
+HARBOL_EXPORT NO_NULL void *harbol_linkmap_key_get_view(const struct HarbolLinkMap *map, struct HarbolStrView key);
+HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_linkmap_key_get_kv_view(const struct HarbolLinkMap *map, struct HarbolStrView key);
+
 HARBOL_EXPORT NO_NULL bool harbol_linkmap_key_set(struct HarbolLinkMap *map, const char key[], void *val);
 HARBOL_EXPORT NO_NULL bool harbol_linkmap_index_set(struct HarbolLinkMap *map, uindex_t index, void *val);
 
+/* 'dtor' works like it does for 'harbol_linkmap_clear'. */
 HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_linkmap_key_del(struct HarbolLinkMap *map, const char key[], void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_linkmap_index_del(struct HarbolLinkMap *map, uindex_t index, void dtor(void**));
 
@@ -113,6 +129,9 @@ HARBOL_EXPORT NO_NULL index_t harbol_linkmap_get_val_index(const struct HarbolLi
 												((map), (key), (dtor))
 #endif
 
+/* iterators walk 'vec' in insertion order as 'struct HarbolKeyVal**'.
+ * deleted pairs leave NULL entries behind until the map compacts itself, so skip NULLs while iterating.
+ */
 HARBOL_EXPORT NO_NULL void *harbol_linkmap_get_iter(const struct HarbolLinkMap *map);
 HARBOL_EXPORT NO_NULL void *harbol_linkmap_get_iter_end_count(const struct HarbolLinkMap *map);
 HARBOL_EXPORT NO_NULL void *harbol_linkmap_get_iter_end_len(const struct HarbolLinkMap *map);
@@ -0,0 +1,237 @@
+#ifndef _POSIX_C_SOURCE
+#	define _POSIX_C_SOURCE 200809L /* rwlocks aren't part of c99. */
+#endif
+#include "concmap.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+#ifdef OS_WINDOWS
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#endif
+
+
+/* each shard is a regular 'HarbolMap' behind its own reader/writer lock.
+ * gets on different keys only contend when they land on the same shard, and even then readers share the lock.
+ */
+struct HarbolConcMapShard {
+#ifdef OS_WINDOWS
+	SRWLOCK lock;
+#else
+	pthread_rwlock_t lock;
+#endif
+	struct HarbolMap map;
+};
+
+enum { HARBOL_CONCMAP_CACHE_LINE = 64 };
+
+static inline NO_NULL void __harbol_concmap_lock_init(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	InitializeSRWLock(&shard->lock);
+#else
+	pthread_rwlock_init(&shard->lock, NULL);
+#endif
+}
+
+static inline NO_NULL void __harbol_concmap_lock_destroy(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	(void)shard;
+#else
+	pthread_rwlock_destroy(&shard->lock);
+#endif
+}
+
+static inline NO_NULL void __harbol_concmap_read_lock(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	AcquireSRWLockShared(&shard->lock);
+#else
+	pthread_rwlock_rdlock(&shard->lock);
+#endif
+}
+
+static inline NO_NULL void __harbol_concmap_read_unlock(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	ReleaseSRWLockShared(&shard->lock);
+#else
+	pthread_rwlock_unlock(&shard->lock);
+#endif
+}
+
+static inline NO_NULL void __harbol_concmap_write_lock(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	AcquireSRWLockExclusive(&shard->lock);
+#else
+	pthread_rwlock_wrlock(&shard->lock);
+#endif
+}
+
+static inline NO_NULL void __harbol_concmap_write_unlock(struct HarbolConcMapShard *const shard)
+{
+#ifdef OS_WINDOWS
+	ReleaseSRWLockExclusive(&shard->lock);
+#else
+	pthread_rwlock_unlock(&shard->lock);
+#endif
+}
+
+static inline NO_NULL struct HarbolConcMapShard *__harbol_concmap_shard_at(const struct HarbolConcMap *const map, const size_t i)
+{
+	return (struct HarbolConcMapShard *)&map->shards[i * map->shard_stride];
+}
+
+/* the top bits pick the shard since each shard's map uses the low bits of its own hashes. */
+static inline NO_NULL struct HarbolConcMapShard *__harbol_concmap_shard(const struct HarbolConcMap *const restrict map, const char key[restrict static 1])
+{
+	size_t keylen = 0;
+	const uint64_t hash = harbol_hash_cstr(key, map->seed, &keylen);
+	return __harbol_concmap_shard_at(map, (size_t)((hash >> 32) & (map->shard_count - 1)));
+}
+
+
+HARBOL_EXPORT struct HarbolConcMap *harbol_concmap_new(const size_t datasize, const size_t shards)
+{
+	struct HarbolConcMap *map = harbol_alloc(1, sizeof *map);
+	if( map != NULL ) {
+		*map = harbol_concmap_create(datasize, shards);
+		if( map->shards==NULL )
+			harbol_free(map), map=NULL;
+	}
+	return map;
+}
+
+HARBOL_EXPORT struct HarbolConcMap harbol_concmap_create(const size_t datasize, const size_t shards)
+{
+	struct HarbolConcMap map = EMPTY_HARBOL_CONCMAP;
+	size_t count = 1;
+	while( count < ((shards==0) ? HARBOL_CONCMAP_DEFAULT_SHARDS : shards) )
+		count <<= 1;
+	
+	/* the extra line is room to align the shards to a cache line. */
+	const size_t stride = harbol_align_size(sizeof(struct HarbolConcMapShard), HARBOL_CONCMAP_CACHE_LINE);
+	map.mem = harbol_alloc(count * stride + HARBOL_CONCMAP_CACHE_LINE, sizeof(uint8_t));
+	if( map.mem==NULL )
+		return map;
+	
+	map.shards = (uint8_t *)harbol_align_size((uintptr_t)map.mem, HARBOL_CONCMAP_CACHE_LINE);
+	map.shard_count = count;
+	map.shard_stride = stride;
+	map.datasize = datasize;
+	map.seed = harbol_hash_seed();
+	for( uindex_t i=0; i<count; i++ ) {
+		struct HarbolConcMapShard *const shard = __harbol_concmap_shard_at(&map, i);
+		__harbol_concmap_lock_init(shard);
+		shard->map = harbol_map_create(datasize);
+	}
+	return map;
+}
+
+HARBOL_EXPORT bool harbol_concmap_clear(struct HarbolConcMap *const map, void dtor(void**))
+{
+	if( map->shards==NULL )
+		return false;
+	else {
+		/* no other thread should be using the map by the time it's cleared. */
+		for( uindex_t i=0; i<map->shard_count; i++ ) {
+			struct HarbolConcMapShard *const shard = __harbol_concmap_shard_at(map, i);
+			harbol_map_clear(&shard->map, dtor);
+			__harbol_concmap_lock_destroy(shard);
+		}
+		harbol_free(map->mem), map->mem=NULL;
+		map->shards = NULL;
+		map->shard_count = map->shard_stride = 0;
+		return true;
+	}
+}
+
+HARBOL_EXPORT bool harbol_concmap_free(struct HarbolConcMap **const mapref, void dtor(void**))
+{
+	if( *mapref==NULL )
+		return false;
+	else {
+		const bool res = harbol_concmap_clear(*mapref, dtor);
+		harbol_free(*mapref), *mapref=NULL;
+		return res;
+	}
+}
+
+HARBOL_EXPORT bool harbol_concmap_insert(struct HarbolConcMap *const restrict map, const char key[restrict static 1], void *const restrict val)
+{
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_write_lock(shard);
+	const bool res = harbol_map_insert(&shard->map, key, val);
+	__harbol_concmap_write_unlock(shard);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_concmap_set(struct HarbolConcMap *const restrict map, const char key[restrict static 1], void *const restrict val)
+{
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_write_lock(shard);
+	const bool res = harbol_map_set(&shard->map, key, val);
+	__harbol_concmap_write_unlock(shard);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_concmap_get(const struct HarbolConcMap *const restrict map, const char key[restrict static 1], void *const restrict out)
+{
+	/* gets never migrate or resize so any number of them can share a shard. */
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_read_lock(shard);
+	const void *const data = harbol_map_get(&shard->map, key);
+	if( data != NULL )
+		memcpy(out, data, map->datasize);
+	__harbol_concmap_read_unlock(shard);
+	return data != NULL;
+}
+
+HARBOL_EXPORT bool harbol_concmap_has_key(const struct HarbolConcMap *const restrict map, const char key[restrict static 1])
+{
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_read_lock(shard);
+	const bool res = harbol_map_has_key(&shard->map, key);
+	__harbol_concmap_read_unlock(shard);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_concmap_del(struct HarbolConcMap *const restrict map, const char key[restrict static 1], void dtor(void**))
+{
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_write_lock(shard);
+	const bool res = harbol_map_del(&shard->map, key, dtor);
+	__harbol_concmap_write_unlock(shard);
+	return res;
+}
+
+HARBOL_EXPORT bool harbol_concmap_update(struct HarbolConcMap *const restrict map, const char key[restrict static 1], void update(void *data, bool inserted, void *ctx), void *const ctx)
+{
+	struct HarbolConcMapShard *const shard = __harbol_concmap_shard(map, key);
+	__harbol_concmap_write_lock(shard);
+	bool inserted = false;
+	void *const data = harbol_map_entry(&shard->map, key, &inserted);
+	if( data != NULL )
+		update(data, inserted, ctx);
+	__harbol_concmap_write_unlock(shard);
+	return data != NULL;
+}
+
+HARBOL_EXPORT size_t harbol_concmap_count(const struct HarbolConcMap *const map)
+{
+	/* shards are counted one at a time so this is only a snapshot while other threads are writing. */
+	size_t count = 0;
+	for( uindex_t i=0; i<map->shard_count; i++ ) {
+		struct HarbolConcMapShard *const shard = __harbol_concmap_shard_at(map, i);
+		__harbol_concmap_read_lock(shard);
+		count += shard->map.count;
+		__harbol_concmap_read_unlock(shard);
+	}
+	return count;
+}
@@ -0,0 +1,50 @@
+#ifndef HARBOL_CONCMAP_INCLUDED
+#	define HARBOL_CONCMAP_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "map.h"
+
+#ifndef HARBOL_CONCMAP_DEFAULT_SHARDS
+#	define HARBOL_CONCMAP_DEFAULT_SHARDS    64
+#endif
+
+
+struct HarbolConcMap {
+	uint8_t *shards; // 'shard_count' shards (lock + 'HarbolMap', private to concmap.c), 'shard_stride' bytes apart so no two share a cache line.
+	void *mem;       // allocation 'shards' is aligned inside of.
+	size_t shard_count, shard_stride, datasize;
+	uint64_t seed;   // picks the shard, each shard map also hashes with its own seed.
+};
+
+#define EMPTY_HARBOL_CONCMAP    {NULL,NULL,0,0,0,0}
+
+/* 'shards' is rounded up to a power of 2, 0 uses the default. */
+HARBOL_EXPORT struct HarbolConcMap *harbol_concmap_new(size_t datasize, size_t shards);
+HARBOL_EXPORT struct HarbolConcMap harbol_concmap_create(size_t datasize, size_t shards);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_concmap_clear(struct HarbolConcMap *map, void dtor(void**));
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_concmap_free(struct HarbolConcMap **mapref, void dtor(void**));
+
+/* every call below is safe to make from any number of threads at once.
+ * since another thread could delete a key at any time, data is always copied in and out rather than handed out by pointer.
+ */
+HARBOL_EXPORT NO_NULL bool harbol_concmap_insert(struct HarbolConcMap *map, const char key[], void *val);
+HARBOL_EXPORT NO_NULL bool harbol_concmap_set(struct HarbolConcMap *map, const char key[], void *val);
+HARBOL_EXPORT NO_NULL bool harbol_concmap_get(const struct HarbolConcMap *map, const char key[], void *out);
+HARBOL_EXPORT NO_NULL bool harbol_concmap_has_key(const struct HarbolConcMap *map, const char key[]);
+HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_concmap_del(struct HarbolConcMap *map, const char key[], void dtor(void**));
+
+/* runs 'update' on the key's data while holding the shard's write lock, the data is zeroed if the key was just inserted. */
+HARBOL_EXPORT NEVER_NULL(1, 2, 3) bool harbol_concmap_update(struct HarbolConcMap *map, const char key[], void update(void *data, bool inserted, void *ctx), void *ctx);
+
+HARBOL_EXPORT NO_NULL size_t harbol_concmap_count(const struct HarbolConcMap *map);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_CONCMAP_INCLUDED */
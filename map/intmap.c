@@ -0,0 +1,255 @@
+#include "intmap.h"
+#include "map_group.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+/* each slot is [uint64_t key][data], padded so every key stays 8-byte aligned. */
+static inline uint64_t *__harbol_intmap_key_at(const struct HarbolIntMap *const map, uint8_t slots[static 1], const size_t slot)
+{
+	return (uint64_t *)&slots[slot * map->stride];
+}
+
+static inline uint8_t *__harbol_intmap_data_at(const struct HarbolIntMap *const map, uint8_t slots[static 1], const size_t slot)
+{
+	return &slots[slot * map->stride + sizeof(uint64_t)];
+}
+
+static inline NO_NULL size_t __harbol_intmap_hash(const struct HarbolIntMap *const map, const uint64_t key)
+{
+	return (size_t)harbol_hash_int(key, map->seed);
+}
+
+static uint8_t *__harbol_intmap_alloc_table(const size_t len, const size_t stride)
+{
+	uint8_t *const slots = harbol_alloc(len, stride + sizeof(uint8_t));
+	if( slots != NULL )
+		memset(&slots[len * stride], HarbolMapCtrl_Empty, len);
+	return slots;
+}
+
+/* returns the slot index of the key or -1, 'free_slot' works the same as in 'HarbolMap'. */
+static NEVER_NULL(1) index_t __harbol_intmap_probe(const struct HarbolIntMap *const restrict map, const uint64_t key, const size_t hash, index_t *const restrict free_slot)
+{
+	const uint8_t h2 = hash & 0x7F;
+	const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	if( free_slot != NULL )
+		*free_slot = -1;
+	
+	for( size_t step=0; step<=group_mask; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		for( uint64_t match = __harbol_map_group_match(&map->ctrl[base], h2); match != 0; match &= match - 1 ) {
+			const size_t slot = base + __harbol_map_lowest_bit(match);
+			if( *__harbol_intmap_key_at(map, map->slots, slot)==key )
+				return slot;
+		}
+		if( free_slot != NULL && *free_slot<0 ) {
+			const uint64_t open = __harbol_map_group_match_free(&map->ctrl[base]);
+			if( open != 0 )
+				*free_slot = base + __harbol_map_lowest_bit(open);
+		}
+		if( __harbol_map_group_match_empty(&map->ctrl[base]) )
+			return -1;
+		group = (group + step + 1) & group_mask;
+	}
+	return -1;
+}
+
+static inline NO_NULL index_t __harbol_intmap_find(const struct HarbolIntMap *const map, const uint64_t key)
+{
+	return( map->slots==NULL ) ? -1 : __harbol_intmap_probe(map, key, __harbol_intmap_hash(map, key), NULL);
+}
+
+static NO_NULL size_t __harbol_intmap_find_free(const struct HarbolIntMap *const map, const size_t hash)
+{
+	const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	for( size_t step=0; ; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		const uint64_t match = __harbol_map_group_match_free(&map->ctrl[base]);
+		if( match != 0 )
+			return base + __harbol_map_lowest_bit(match);
+		group = (group + step + 1) & group_mask;
+	}
+}
+
+static NEVER_NULL(1) void __harbol_intmap_dtor_slot(const struct HarbolIntMap *const map, const size_t slot, void dtor(void**))
+{
+	if( dtor != NULL )
+		dtor((void**)&(uint8_t *){__harbol_intmap_data_at(map, map->slots, slot)});
+}
+
+
+HARBOL_EXPORT struct HarbolIntMap *harbol_intmap_new(const size_t datasize)
+{
+	struct HarbolIntMap *map = harbol_alloc(1, sizeof *map);
+	if( map != NULL )
+		*map = harbol_intmap_create(datasize);
+	return map;
+}
+
+HARBOL_EXPORT struct HarbolIntMap harbol_intmap_create(const size_t datasize)
+{
+	struct HarbolIntMap map = {
+		.datasize = datasize,
+		.stride = harbol_align_size(sizeof(uint64_t) + datasize, sizeof(uint64_t)),
+		.seed = harbol_hash_seed()
+	};
+	return map;
+}
+
+HARBOL_EXPORT bool harbol_intmap_clear(struct HarbolIntMap *const map, void dtor(void**))
+{
+	if( map->slots==NULL || map->datasize==0 )
+		return false;
+	else {
+		if( dtor != NULL )
+			for( uindex_t i=0; i<map->len; i++ )
+				if( map->ctrl[i] < HarbolMapCtrl_Empty )
+					__harbol_intmap_dtor_slot(map, i, dtor);
+		harbol_free(map->slots), map->slots=NULL;
+		map->ctrl = NULL;
+		map->len = map->count = map->tombs = 0;
+		return true;
+	}
+}
+
+HARBOL_EXPORT bool harbol_intmap_free(struct HarbolIntMap **const mapref, void dtor(void**))
+{
+	if( *mapref==NULL )
+		return false;
+	else {
+		const bool res = harbol_intmap_clear(*mapref, dtor);
+		harbol_free(*mapref), *mapref=NULL;
+		return res;
+	}
+}
+
+HARBOL_EXPORT bool harbol_intmap_insert(struct HarbolIntMap *const restrict map, const uint64_t key, void *const restrict val)
+{
+	bool inserted = false;
+	void *const data = harbol_intmap_entry(map, key, &inserted);
+	if( data==NULL || !inserted )
+		return false;
+	else {
+		memcpy(data, val, map->datasize);
+		return true;
+	}
+}
+
+HARBOL_EXPORT void *harbol_intmap_entry(struct HarbolIntMap *const restrict map, const uint64_t key, bool *const restrict inserted)
+{
+	if( inserted != NULL )
+		*inserted = false;
+	
+	if( map->datasize==0 )
+		return NULL;
+	
+	const size_t hash = __harbol_intmap_hash(map, key);
+	index_t slot = -1;
+	if( map->slots != NULL ) {
+		const index_t found = __harbol_intmap_probe(map, key, hash, &slot);
+		if( found >= 0 )
+			return __harbol_intmap_data_at(map, map->slots, found);
+	}
+	
+	if( map->len==0 || map->count + map->tombs >= __harbol_map_max_load(map->len) ) {
+		/* same growth rule as 'HarbolMap', mostly tombstones means rehash at the same size. */
+		const size_t new_len = (map->len==0) ? MAP_DEFAULT_SIZE : (map->count >= (map->len >> 1)) ? map->len << 1 : map->len;
+		if( !harbol_intmap_rehash(map, new_len) )
+			return NULL;
+		slot = __harbol_intmap_find_free(map, hash);
+	}
+	
+	if( map->ctrl[slot]==HarbolMapCtrl_Deleted )
+		map->tombs--;
+	map->ctrl[slot] = hash & 0x7F;
+	*__harbol_intmap_key_at(map, map->slots, slot) = key;
+	uint8_t *const data = __harbol_intmap_data_at(map, map->slots, slot);
+	memset(data, 0, map->datasize);
+	map->count++;
+	if( inserted != NULL )
+		*inserted = true;
+	return data;
+}
+
+HARBOL_EXPORT void *harbol_intmap_get(const struct HarbolIntMap *const map, const uint64_t key)
+{
+	const index_t slot = __harbol_intmap_find(map, key);
+	return( slot<0 ) ? NULL : __harbol_intmap_data_at(map, map->slots, slot);
+}
+
+HARBOL_EXPORT bool harbol_intmap_set(struct HarbolIntMap *const restrict map, const uint64_t key, void *const restrict val)
+{
+	void *const data = harbol_intmap_entry(map, key, NULL);
+	return( data==NULL ) ? false : memcpy(data, val, map->datasize) != NULL;
+}
+
+HARBOL_EXPORT bool harbol_intmap_has_key(const struct HarbolIntMap *const map, const uint64_t key)
+{
+	return __harbol_intmap_find(map, key) >= 0;
+}
+
+HARBOL_EXPORT bool harbol_intmap_rehash(struct HarbolIntMap *const map, const size_t new_len)
+{
+	const size_t len = __harbol_map_table_len(new_len, map->count);
+	const size_t old_len = map->len;
+	uint8_t *const curr = map->slots;
+	const uint8_t *const curr_ctrl = map->ctrl;
+	
+	map->slots = __harbol_intmap_alloc_table(len, map->stride);
+	if( map->slots==NULL ) {
+		map->slots = curr;
+		return false;
+	} else {
+		map->ctrl = &map->slots[len * map->stride];
+		map->len = len;
+		map->tombs = 0;
+		if( curr != NULL ) {
+			/* integer keys are cheap to rehash so there's no need to cache the hashes. */
+			for( uindex_t i=0; i<old_len; i++ ) {
+				if( curr_ctrl[i] >= HarbolMapCtrl_Empty )
+					continue;
+				const uint64_t key = *__harbol_intmap_key_at(map, curr, i);
+				const size_t hash = __harbol_intmap_hash(map, key);
+				const size_t slot = __harbol_intmap_find_free(map, hash);
+				map->ctrl[slot] = hash & 0x7F;
+				memcpy(&map->slots[slot * map->stride], &curr[i * map->stride], map->stride);
+			}
+			harbol_free(curr);
+		}
+		return true;
+	}
+}
+
+HARBOL_EXPORT bool harbol_intmap_del(struct HarbolIntMap *const map, const uint64_t key, void dtor(void**))
+{
+	const index_t slot = __harbol_intmap_find(map, key);
+	if( slot<0 )
+		return false;
+	else {
+		__harbol_intmap_dtor_slot(map, slot, dtor);
+		const size_t base = slot & ~(size_t)(HARBOL_MAP_GROUP_WIDTH - 1);
+		if( __harbol_map_group_match_empty(&map->ctrl[base]) ) {
+			map->ctrl[slot] = HarbolMapCtrl_Empty;
+		} else {
+			map->ctrl[slot] = HarbolMapCtrl_Deleted;
+			map->tombs++;
+		}
+		map->count--;
+		return true;
+	}
+}
+
+HARBOL_EXPORT uint64_t harbol_intmap_slot_key(const struct HarbolIntMap *const map, const size_t slot)
+{
+	return *__harbol_intmap_key_at(map, map->slots, slot);
+}
+
+HARBOL_EXPORT void *harbol_intmap_slot_data(const struct HarbolIntMap *const map, const size_t slot)
+{
+	return __harbol_intmap_data_at(map, map->slots, slot);
+}
@@ -0,0 +1,49 @@
+#ifndef HARBOL_INTMAP_INCLUDED
+#	define HARBOL_INTMAP_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "map.h"
+
+
+/* same probing scheme as 'HarbolMap' but keyed by integers, pointer keys go in as '(uintptr_t)ptr'.
+ * keys and data are stored inline in the slots so there's no allocation per key.
+ * since data lives in the table itself, pointers to it are only good until the next insert or rehash.
+ */
+struct HarbolIntMap {
+	uint8_t *slots; // flat array of 'stride' sized slots, each a key followed by its data. 'ctrl' is allocated right after it.
+	uint8_t *ctrl;
+	size_t len, count, datasize, stride, tombs;
+	uint64_t seed;
+};
+
+#define EMPTY_HARBOL_INTMAP    {NULL,NULL,0,0,0,0,0,0}
+
+HARBOL_EXPORT struct HarbolIntMap *harbol_intmap_new(size_t datasize);
+HARBOL_EXPORT struct HarbolIntMap harbol_intmap_create(size_t datasize);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_intmap_clear(struct HarbolIntMap *map, void dtor(void**));
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_intmap_free(struct HarbolIntMap **mapref, void dtor(void**));
+
+HARBOL_EXPORT NO_NULL bool harbol_intmap_insert(struct HarbolIntMap *map, uint64_t key, void *val);
+HARBOL_EXPORT NEVER_NULL(1) void *harbol_intmap_entry(struct HarbolIntMap *map, uint64_t key, bool *inserted);
+
+HARBOL_EXPORT NO_NULL void *harbol_intmap_get(const struct HarbolIntMap *map, uint64_t key);
+HARBOL_EXPORT NO_NULL bool harbol_intmap_set(struct HarbolIntMap *map, uint64_t key, void *val);
+
+HARBOL_EXPORT NO_NULL bool harbol_intmap_has_key(const struct HarbolIntMap *map, uint64_t key);
+HARBOL_EXPORT NO_NULL bool harbol_intmap_rehash(struct HarbolIntMap *map, size_t new_len);
+HARBOL_EXPORT NEVER_NULL(1) bool harbol_intmap_del(struct HarbolIntMap *map, uint64_t key, void dtor(void**));
+
+/* slot accessors for walking the table: slots with 'ctrl[i] < 0x80' are in use. */
+HARBOL_EXPORT NO_NULL uint64_t harbol_intmap_slot_key(const struct HarbolIntMap *map, size_t slot);
+HARBOL_EXPORT NO_NULL void *harbol_intmap_slot_data(const struct HarbolIntMap *map, size_t slot);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_INTMAP_INCLUDED */
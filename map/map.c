@@ -1,35 +1,257 @@
-#include "map.h"
+#include "map_group.h"
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
 #endif
 
+static inline NO_NULL size_t __harbol_map_hash(const struct HarbolMap *const restrict map, const char key[restrict static 1], size_t *const restrict len)
+{
+	return (size_t)harbol_hash_cstr(key, map->seed, len);
+}
 
-HARBOL_EXPORT struct HarbolKeyVal *harbol_kvpair_new(const char cstr[restrict static 1], void *const restrict data, const size_t datasize)
+/* slot pointers and control bytes share one allocation, the control bytes start right after the last slot. */
+static struct HarbolKeyVal **__harbol_map_alloc_table(const struct HarbolAllocator *const alloc, const size_t len)
 {
-	struct HarbolKeyVal *kv = harbol_alloc(1, sizeof *kv);
-	if( kv != NULL ) {
-		kv->data = harbol_alloc(datasize, sizeof *kv->data);
-		if( kv->data==NULL ) {
-			harbol_free(kv), kv=NULL;
-		} else {
-			kv->key = harbol_string_create(cstr);
-			if( kv->key.cstr==NULL )
-				harbol_free(kv), kv=NULL;
-			else memcpy(kv->data, data, datasize);
+	struct HarbolKeyVal **const buckets = harbol_alloc_with(alloc, len, sizeof *buckets + sizeof(uint8_t));
+	if( buckets != NULL )
+		memset(&buckets[len], HarbolMapCtrl_Empty, len);
+	return buckets;
+}
+
+/* single pass lookup, returns the slot index of the key or -1 if the key isn't in the table.
+ * if 'free_slot' is given, it's set to the first empty or deleted slot seen along the probe sequence so an insert can reuse the probe.
+ */
+static NEVER_NULL(1, 2, 4) index_t __harbol_map_probe(struct HarbolKeyVal *const buckets[static 1], const uint8_t ctrl[static HARBOL_MAP_GROUP_WIDTH], const size_t len, const char key[restrict static 1], const size_t keylen, const size_t hash, index_t *const restrict free_slot)
+{
+	const uint8_t h2 = hash & 0x7F;
+	const size_t group_mask = (len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	if( free_slot != NULL )
+		*free_slot = -1;
+	
+	for( size_t step=0; step<=group_mask; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		for( uint64_t match = __harbol_map_group_match(&ctrl[base], h2); match != 0; match &= match - 1 ) {
+			const size_t slot = base + __harbol_map_lowest_bit(match);
+			const struct HarbolKeyVal *const kv = buckets[slot];
+			/* only touch the key bytes when the full hash and length both agree. */
+			if( kv->hash==hash && harbol_string_len(&kv->key)==keylen && !memcmp(harbol_string_cstr(&kv->key), key, keylen) )
+				return slot;
+		}
+		if( free_slot != NULL && *free_slot<0 ) {
+			const uint64_t open = __harbol_map_group_match_free(&ctrl[base]);
+			if( open != 0 )
+				*free_slot = base + __harbol_map_lowest_bit(open);
+		}
+		/* any empty slot in the group means the key was never probed past here. */
+		if( __harbol_map_group_match_empty(&ctrl[base]) )
+			return -1;
+		group = (group + step + 1) & group_mask;
+	}
+	return -1;
+}
+
+/* looks in the current table first, then in the table still being migrated from.
+ * 'free_slot' only ever refers to the current table.
+ */
+static NEVER_NULL(1, 2) struct HarbolKeyVal **__harbol_map_lookup(const struct HarbolMap *const restrict map, const char key[restrict static 1], const size_t keylen, const size_t hash, index_t *const restrict free_slot)
+{
+	if( free_slot != NULL )
+		*free_slot = -1;
+	
+	if( map->buckets != NULL ) {
+		const index_t slot = __harbol_map_probe(map->buckets, map->ctrl, map->len, key, keylen, hash, free_slot);
+		if( slot >= 0 )
+			return &map->buckets[slot];
+	}
+	if( map->old.buckets != NULL ) {
+		const index_t slot = __harbol_map_probe(map->old.buckets, map->old.ctrl, map->old.len, key, keylen, hash, NULL);
+		if( slot >= 0 )
+			return &map->old.buckets[slot];
+	}
+	return NULL;
+}
+
+static inline NO_NULL struct HarbolKeyVal **__harbol_map_find(const struct HarbolMap *const restrict map, const char key[restrict static 1])
+{
+	if( map->buckets==NULL )
+		return NULL;
+	else {
+		size_t keylen = 0;
+		const size_t hash = __harbol_map_hash(map, key, &keylen);
+		return __harbol_map_lookup(map, key, keylen, hash, NULL);
+	}
+}
+
+static inline NO_NULL struct HarbolKeyVal **__harbol_map_find_view(const struct HarbolMap *const restrict map, const struct HarbolStrView key)
+{
+	if( map->buckets==NULL || key.ptr==NULL )
+		return NULL;
+	else {
+		/* hashing the bytes directly gives the same hash the null terminated key would get. */
+		const size_t hash = (size_t)harbol_hash_bytes(key.ptr, key.len, map->seed);
+		return __harbol_map_lookup(map, key.ptr, key.len, hash, NULL);
+	}
+}
+
+/* returns the first empty or deleted slot along the key's probe sequence in the current table. */
+static NO_NULL size_t __harbol_map_find_free(const struct HarbolMap *const map, const size_t hash)
+{
+	const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+	size_t group = (hash >> 7) & group_mask;
+	for( size_t step=0; ; step++ ) {
+		const size_t base = group * HARBOL_MAP_GROUP_WIDTH;
+		const uint64_t match = __harbol_map_group_match_free(&map->ctrl[base]);
+		if( match != 0 )
+			return base + __harbol_map_lowest_bit(match);
+		group = (group + step + 1) & group_mask;
+	}
+}
+
+/* puts a pair into a free slot of the current table, the caller does the counting. */
+static NO_NULL void __harbol_map_place(struct HarbolMap *const restrict map, struct HarbolKeyVal *const restrict kv, const size_t slot, const size_t hash)
+{
+	if( map->ctrl[slot]==HarbolMapCtrl_Deleted )
+		map->tombs--;
+	kv->hash = hash;
+	map->ctrl[slot] = hash & 0x7F;
+	map->buckets[slot] = kv;
+}
+
+/* moves up to 'slots' slots' worth of pairs from the old table into the current one.
+ * hashes are cached in each pair so this is only moving pointers.
+ */
+static NO_NULL void __harbol_map_migrate(struct HarbolMap *const map, const size_t slots)
+{
+	const size_t left = map->old.len - map->old.cursor;
+	const size_t end = (slots >= left) ? map->old.len : map->old.cursor + slots;
+	for( ; map->old.cursor < end; map->old.cursor++ ) {
+		const size_t i = map->old.cursor;
+		if( map->old.ctrl[i] < HarbolMapCtrl_Empty ) {
+			struct HarbolKeyVal *const kv = map->old.buckets[i];
+			__harbol_map_place(map, kv, __harbol_map_find_free(map, kv->hash), kv->hash);
+			/* lookups still probe the old table, so leave a tombstone that keeps its probe chains intact. */
+			map->old.ctrl[i] = HarbolMapCtrl_Deleted;
 		}
 	}
+	if( map->old.cursor >= map->old.len ) {
+		harbol_free_with(map->alloc, map->old.buckets), map->old.buckets = NULL;
+		map->old.ctrl = NULL;
+		map->old.len = map->old.cursor = map->old.step = 0;
+	}
+}
+
+/* mutating calls pay for a piece of any pending migration. */
+static inline NO_NULL void __harbol_map_migrate_step(struct HarbolMap *const map)
+{
+	if( map->old.buckets != NULL )
+		__harbol_map_migrate(map, map->old.step);
+}
+
+static NO_NULL bool __harbol_map_grow(struct HarbolMap *const map)
+{
+	/* lots of tombstones? rehash at the same size to flush them out. */
+	const size_t new_len = (map->len==0) ? MAP_DEFAULT_SIZE : (map->count >= (map->len >> 1)) ? map->len << 1 : map->len;
+	if( map->rehash_step==0 || map->buckets==NULL )
+		return harbol_map_rehash(map, new_len);
+	else {
+		/* a previous migration that hasn't finished yet has to be done before a new one can start. */
+		if( map->old.buckets != NULL )
+			__harbol_map_migrate(map, map->old.len);
+		
+		const size_t len = __harbol_map_table_len(new_len, map->count);
+		struct HarbolKeyVal **const buckets = __harbol_map_alloc_table(map->alloc, len);
+		if( buckets==NULL )
+			return false;
+		else {
+			map->old.buckets = map->buckets;
+			map->old.ctrl = map->ctrl;
+			map->old.len = map->len;
+			map->old.cursor = 0;
+			
+			map->buckets = buckets;
+			map->ctrl = (uint8_t *)&buckets[len];
+			map->len = len;
+			map->tombs = 0;
+			
+			/* only inserts eat into the new table's headroom and each one takes a step,
+			 * so spreading the old slots over that headroom finishes the migration before the next grow.
+			 * a same size rehash for tombstones has less headroom than a doubling, so it takes bigger steps.
+			 */
+			const size_t room = __harbol_map_max_load(len) - map->count;
+			const size_t needed = (map->old.len + room - 1) / room;
+			map->old.step = (needed > map->rehash_step) ? needed : map->rehash_step;
+			__harbol_map_migrate(map, map->old.step);
+			return true;
+		}
+	}
+}
+
+/* makes room for one more key if needed, returns the free slot to put it into.
+ * 'free_slot' is what the lookup probe found, it's only recomputed if the table had to grow.
+ * 'count' covers both tables during a migration so it's an upper bound on what the current table holds.
+ */
+static NO_NULL index_t __harbol_map_reserve_slot(struct HarbolMap *const map, const size_t hash, const index_t free_slot)
+{
+	if( map->len==0 || map->count + map->tombs >= __harbol_map_max_load(map->len) )
+		return( !__harbol_map_grow(map) ) ? -1 : (index_t)__harbol_map_find_free(map, hash);
+	return free_slot;
+}
+
+/* pair header, data, and key bytes all live in one allocation:
+ * [struct HarbolKeyVal][data (datasize bytes)][key bytes + '\0']
+ */
+static struct HarbolKeyVal *__harbol_kvpair_make(const struct HarbolAllocator *const alloc, const char cstr[restrict static 1], const size_t keylen, const size_t datasize)
+{
+	/* keep the data at the same alignment malloc would give it. */
+	const size_t data_offs = harbol_align_size(sizeof(struct HarbolKeyVal), 2 * sizeof(uintptr_t));
+	uint8_t *const block = harbol_alloc_with(alloc, data_offs + datasize + keylen + 1, sizeof *block);
+	if( block==NULL )
+		return NULL;
+	else {
+		struct HarbolKeyVal *const kv = (struct HarbolKeyVal *)block;
+		kv->data = &block[data_offs];
+		char *const key = (char *)&block[data_offs + datasize];
+		memcpy(key, cstr, keylen);
+		/* the key lives in the pair's own block so it only gets borrowed. */
+		kv->key = harbol_string_borrow(key, keylen);
+		return kv;
+	}
+}
+
+static NEVER_NULL(2) void __harbol_kvpair_destroy(const struct HarbolAllocator *const alloc, struct HarbolKeyVal **const kvpairref, void dtor(void**))
+{
+	/* data is part of the pair's allocation so, like vector elements, 'dtor' gets a pointer to a copy of the data pointer. */
+	if( dtor != NULL )
+		dtor((void**)&(uint8_t *){(*kvpairref)->data});
+	harbol_free_with(alloc, *kvpairref), *kvpairref=NULL;
+}
+
+
+HARBOL_EXPORT struct HarbolKeyVal *harbol_kvpair_new(const char cstr[restrict static 1], void *const restrict data, const size_t datasize)
+{
+	return harbol_kvpair_new_with(NULL, cstr, data, datasize);
+}
+
+HARBOL_EXPORT struct HarbolKeyVal *harbol_kvpair_new_with(const struct HarbolAllocator *const alloc, const char cstr[restrict static 1], void *const restrict data, const size_t datasize)
+{
+	struct HarbolKeyVal *kv = __harbol_kvpair_make(alloc, cstr, strlen(cstr), datasize);
+	if( kv != NULL )
+		memcpy(kv->data, data, datasize);
 	return kv;
 }
 
 HARBOL_EXPORT bool harbol_kvpair_free(struct HarbolKeyVal **const kvpairref, void dtor(void**))
 {
-	harbol_string_clear(&(*kvpairref)->key);
-	if( dtor != NULL )
-		dtor((void**)&(*kvpairref)->data);
-	if( (*kvpairref)->data != NULL )
-		harbol_free((*kvpairref)->data), (*kvpairref)->data = NULL;
-	harbol_free(*kvpairref), *kvpairref=NULL;
+	return harbol_kvpair_free_with(NULL, kvpairref, dtor);
+}
+
+HARBOL_EXPORT bool harbol_kvpair_free_with(const struct HarbolAllocator *const alloc, struct HarbolKeyVal **const kvpairref, void dtor(void**))
+{
+	if( *kvpairref==NULL )
+		return false;
+	
+	__harbol_kvpair_destroy(alloc, kvpairref, dtor);
 	return true;
 }
 
@@ -44,7 +266,12 @@ HARBOL_EXPORT struct HarbolMap *harbol_map_new(const size_t datasize)
 
 HARBOL_EXPORT struct HarbolMap harbol_map_create(const size_t datasize)
 {
-	struct HarbolMap map = {.datasize = datasize};
+	return harbol_map_create_with(datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolMap harbol_map_create_with(const size_t datasize, const struct HarbolAllocator *const alloc)
+{
+	struct HarbolMap map = {.datasize = datasize, .seed = harbol_hash_seed(), .alloc = alloc};
 	return map;
 }
 
@@ -53,13 +280,19 @@ HARBOL_EXPORT bool harbol_map_clear(struct HarbolMap *const map, void dtor(void*
 	if( map->buckets==NULL || map->datasize==0 )
 		return false;
 	else {
-		for( uindex_t i=0; i<map->len; i++ ) {
-			struct HarbolVector *const bucket = &map->buckets[i];
-			for( uindex_t a=0; a<bucket->count; a++ )
-				harbol_kvpair_free(harbol_vector_get(bucket, a), dtor);
-			harbol_vector_clear(bucket, NULL);
+		for( uindex_t i=0; i<map->len; i++ )
+			if( map->ctrl[i] < HarbolMapCtrl_Empty )
+				__harbol_kvpair_destroy(map->alloc, &map->buckets[i], dtor);
+		harbol_free_with(map->alloc, map->buckets), map->buckets=NULL;
+		
+		if( map->old.buckets != NULL ) {
+			for( uindex_t i=map->old.cursor; i<map->old.len; i++ )
+				if( map->old.ctrl[i] < HarbolMapCtrl_Empty )
+					__harbol_kvpair_destroy(map->alloc, &map->old.buckets[i], dtor);
+			harbol_free_with(map->alloc, map->old.buckets), map->old.buckets=NULL;
 		}
-		harbol_free(map->buckets), map->buckets=NULL;
+		map->ctrl = map->old.ctrl = NULL;
+		map->len = map->count = map->tombs = map->old.len = map->old.cursor = map->old.step = 0;
 		return true;
 	}
 }
@@ -77,149 +310,227 @@ HARBOL_EXPORT bool harbol_map_free(struct HarbolMap **mapref, void dtor(void**))
 
 HARBOL_EXPORT bool harbol_map_insert(struct HarbolMap *const restrict map, const char key[restrict static 1], void *restrict val)
 {
-	if( map->datasize==0 )
+	bool inserted = false;
+	void *const data = harbol_map_entry(map, key, &inserted);
+	if( data==NULL || !inserted )
 		return false;
 	else {
-		struct HarbolKeyVal *kv = harbol_kvpair_new(key, val, map->datasize);
-		if( kv==NULL ) {
-			return false;
-		} else {
-			const bool result = harbol_map_insert_kv(map, kv);
-			if( !result ) {
-				harbol_kvpair_free(&kv, NULL);
-				return false;
-			}
-			else return true;
-		}
+		memcpy(data, val, map->datasize);
+		return true;
 	}
 }
 
 HARBOL_EXPORT bool harbol_map_insert_kv(struct HarbolMap *const map, struct HarbolKeyVal *kv)
 {
-	if( harbol_map_has_key(map, kv->key.cstr) )
+	__harbol_map_migrate_step(map);
+	size_t keylen = 0;
+	const size_t hash = __harbol_map_hash(map, harbol_string_cstr(&kv->key), &keylen);
+	index_t slot = -1;
+	if( __harbol_map_lookup(map, harbol_string_cstr(&kv->key), keylen, hash, &slot) != NULL )
 		return false;
 	else {
-		if( map->len==0 || map->count >= map->len )
-			harbol_map_rehash(map, (map->len==0) ? MAP_DEFAULT_SIZE : map->len << 1);
-		
-		const size_t hash = string_hash(kv->key.cstr) % map->len;
-		struct HarbolVector *bucket = &map->buckets[hash];
-		if( bucket->datasize==0 )
-			bucket->datasize = sizeof(struct HarbolKeyVal *);
-		harbol_vector_insert(bucket, &kv);
-		map->count++;
-		return true;
+		slot = __harbol_map_reserve_slot(map, hash, slot);
+		if( slot<0 )
+			return false;
+		else {
+			__harbol_map_place(map, kv, slot, hash);
+			map->count++;
+			return true;
+		}
 	}
 }
 
-HARBOL_EXPORT void *harbol_map_get(const struct HarbolMap *const restrict map, const char key[restrict static 1])
+static NEVER_NULL(1, 2) void *__harbol_map_entry(struct HarbolMap *const restrict map, const char key[restrict static 1], const size_t keylen, const size_t hash, bool *const restrict inserted)
 {
-	if( map->buckets==NULL || !harbol_map_has_key(map, key) )
+	if( inserted != NULL )
+		*inserted = false;
+	
+	if( map->datasize==0 )
 		return NULL;
 	else {
-		const size_t hash = string_hash(key) % map->len;
-		struct HarbolVector *const bucket = &map->buckets[hash];
-		for( uindex_t i=0; i<bucket->count; i++ ) {
-			struct HarbolKeyVal **const kv = harbol_vector_get(bucket, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) )
-				return (*kv)->data;
+		__harbol_map_migrate_step(map);
+		index_t slot = -1;
+		struct HarbolKeyVal **const found = __harbol_map_lookup(map, key, keylen, hash, &slot);
+		if( found != NULL )
+			return (*found)->data;
+		
+		slot = __harbol_map_reserve_slot(map, hash, slot);
+		if( slot<0 )
+			return NULL;
+		else {
+			struct HarbolKeyVal *const kv = __harbol_kvpair_make(map->alloc, key, keylen, map->datasize);
+			if( kv==NULL )
+				return NULL;
+			else {
+				__harbol_map_place(map, kv, slot, hash);
+				map->count++;
+				if( inserted != NULL )
+					*inserted = true;
+				return kv->data;
+			}
 		}
+	}
+}
+
+HARBOL_EXPORT void *harbol_map_entry(struct HarbolMap *const restrict map, const char key[restrict static 1], bool *const restrict inserted)
+{
+	size_t keylen = 0;
+	const size_t hash = __harbol_map_hash(map, key, &keylen);
+	return __harbol_map_entry(map, key, keylen, hash, inserted);
+}
+
+HARBOL_EXPORT void *harbol_map_entry_view(struct HarbolMap *const restrict map, const struct HarbolStrView key, bool *const restrict inserted)
+{
+	if( key.ptr==NULL ) {
+		if( inserted != NULL )
+			*inserted = false;
 		return NULL;
+	} else {
+		return __harbol_map_entry(map, key.ptr, key.len, (size_t)harbol_hash_bytes(key.ptr, key.len, map->seed), inserted);
 	}
 }
 
+HARBOL_EXPORT void *harbol_map_get(const struct HarbolMap *const restrict map, const char key[restrict static 1])
+{
+	struct HarbolKeyVal **const kv = __harbol_map_find(map, key);
+	return( kv==NULL ) ? NULL : (*kv)->data;
+}
+
 HARBOL_EXPORT struct HarbolKeyVal *harbol_map_get_kv(const struct HarbolMap *const restrict map, const char key[restrict static 1])
 {
-	if( map->buckets==NULL )
-		return NULL;
-	else {
-		const size_t hash = string_hash(key) % map->len;
-		struct HarbolVector *const bucket = &map->buckets[hash];
-		for( uindex_t i=0; i<bucket->count; i++ ) {
-			struct HarbolKeyVal **kv = harbol_vector_get(bucket, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) )
-				return *kv;
+	struct HarbolKeyVal **const kv = __harbol_map_find(map, key);
+	return( kv==NULL ) ? NULL : *kv;
+}
+
+HARBOL_EXPORT void *harbol_map_get_view(const struct HarbolMap *const map, const struct HarbolStrView key)
+{
+	struct HarbolKeyVal **const kv = __harbol_map_find_view(map, key);
+	return( kv==NULL ) ? NULL : (*kv)->data;
+}
+
+HARBOL_EXPORT struct HarbolKeyVal *harbol_map_get_kv_view(const struct HarbolMap *const map, const struct HarbolStrView key)
+{
+	struct HarbolKeyVal **const kv = __harbol_map_find_view(map, key);
+	return( kv==NULL ) ? NULL : *kv;
+}
+
+HARBOL_EXPORT size_t harbol_map_get_many(const struct HarbolMap *const restrict map, const char *const keys[restrict static 1], const size_t n, void *out[restrict static 1])
+{
+	/* keys go through in small batches: hash everything & prefetch the first control group,
+	 * then prefetch the pairs whose tags match, then do the real probes once the lines are (hopefully) in cache.
+	 */
+	enum { BATCH = 16 };
+	size_t hashes[BATCH], lens[BATCH];
+	size_t found = 0;
+	for( uindex_t i=0; i<n; i += BATCH ) {
+		const size_t batch = (n - i < BATCH) ? n - i : BATCH;
+		if( map->buckets==NULL ) {
+			for( uindex_t k=0; k<batch; k++ )
+				out[i + k] = NULL;
+			continue;
+		}
+		
+		const size_t group_mask = (map->len / HARBOL_MAP_GROUP_WIDTH) - 1;
+		for( uindex_t k=0; k<batch; k++ ) {
+			hashes[k] = __harbol_map_hash(map, keys[i + k], &lens[k]);
+			const size_t base = ((hashes[k] >> 7) & group_mask) * HARBOL_MAP_GROUP_WIDTH;
+			HARBOL_PREFETCH(&map->ctrl[base]);
+			HARBOL_PREFETCH(&map->buckets[base]);
+		}
+		for( uindex_t k=0; k<batch; k++ ) {
+			const size_t base = ((hashes[k] >> 7) & group_mask) * HARBOL_MAP_GROUP_WIDTH;
+			const uint64_t match = __harbol_map_group_match(&map->ctrl[base], hashes[k] & 0x7F);
+			if( match != 0 )
+				HARBOL_PREFETCH(map->buckets[base + __harbol_map_lowest_bit(match)]);
+		}
+		for( uindex_t k=0; k<batch; k++ ) {
+			struct HarbolKeyVal **const kv = __harbol_map_lookup(map, keys[i + k], lens[k], hashes[k], NULL);
+			out[i + k] = ( kv==NULL ) ? NULL : (*kv)->data;
+			found += kv != NULL;
 		}
-		return NULL;
 	}
+	return found;
 }
 
 HARBOL_EXPORT bool harbol_map_set(struct HarbolMap *const restrict map, const char key[restrict static 1], void *const restrict val)
 {
-	if( map->datasize==0 )
-		return false;
-	else if( map->buckets==NULL || !harbol_map_has_key(map, key) )
-		return harbol_map_insert(map, key, val);
-	else {
-		const size_t hash = string_hash(key) % map->len;
-		struct HarbolVector *const bucket = &map->buckets[hash];
-		for( uindex_t i=0; i<bucket->count; i++ ) {
-			struct HarbolKeyVal **const kv = harbol_vector_get(bucket, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) ) {
-				memcpy((*kv)->data, val, map->datasize);
-				return true;
-			}
-		}
-		return false;
-	}
+	void *const data = harbol_map_entry(map, key, NULL);
+	return( data==NULL ) ? false : memcpy(data, val, map->datasize) != NULL;
 }
 
 HARBOL_EXPORT bool harbol_map_has_key(const struct HarbolMap *const restrict map, const char key[restrict static 1])
 {
-	if( map->buckets==NULL )
-		return false;
-	else {
-		const size_t hash = string_hash(key) % map->len;
-		struct HarbolVector *const bucket = &map->buckets[hash];
-		for( uindex_t i=0; i<bucket->count; i++ ) {
-			struct HarbolKeyVal **const kv = harbol_vector_get(bucket, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) )
-				return true;
-		}
-		return false;
-	}
+	return __harbol_map_find(map, key) != NULL;
+}
+
+HARBOL_EXPORT bool harbol_map_has_key_view(const struct HarbolMap *const map, const struct HarbolStrView key)
+{
+	return __harbol_map_find_view(map, key) != NULL;
 }
 
 HARBOL_EXPORT bool harbol_map_rehash(struct HarbolMap *const map, const size_t new_len)
 {
+	/* explicit rehashes are always done in one go. */
+	if( map->old.buckets != NULL )
+		__harbol_map_migrate(map, map->old.len);
+	
+	const size_t len = __harbol_map_table_len(new_len, map->count);
 	const size_t old_len = map->len;
-	struct HarbolVector *curr = map->buckets;
-	map->buckets = harbol_alloc(new_len, sizeof *map->buckets);
+	struct HarbolKeyVal **const curr = map->buckets;
+	const uint8_t *const curr_ctrl = map->ctrl;
+	
+	map->buckets = __harbol_map_alloc_table(map->alloc, len);
 	if( map->buckets==NULL ) {
 		map->buckets = curr;
 		return false;
 	} else {
-		map->len = new_len;
-		map->count = 0;
+		map->ctrl = (uint8_t *)&map->buckets[len];
+		map->len = len;
+		map->tombs = 0;
 		if( curr != NULL ) {
-			for( uindex_t i=0; i<old_len; i++ ) {
-				struct HarbolVector *entry = &curr[i];
-				for( uindex_t a=0; a<entry->count; a++ )
-					harbol_map_insert_kv(map, *(struct HarbolKeyVal **)harbol_vector_get(entry, a));
-				harbol_free(entry->table), entry->table = NULL;
-			}
-			harbol_free(curr), curr=NULL;
+			/* hashes are cached in each pair so growing is only moving pointers. */
+			for( uindex_t i=0; i<old_len; i++ )
+				if( curr_ctrl[i] < HarbolMapCtrl_Empty )
+					__harbol_map_place(map, curr[i], __harbol_map_find_free(map, curr[i]->hash), curr[i]->hash);
+			harbol_free_with(map->alloc, curr);
 		}
 		return true;
 	}
 }
 
+HARBOL_EXPORT void harbol_map_set_rehash_step(struct HarbolMap *const map, const size_t slots)
+{
+	/* this is only the smallest step, growing picks a bigger one if the new table's headroom needs it. */
+	map->rehash_step = slots;
+}
+
 HARBOL_EXPORT bool harbol_map_del(struct HarbolMap *const restrict map, const char key[restrict static 1], void dtor(void**))
 {
-	if( map->buckets==NULL || !harbol_map_has_key(map, key) )
+	if( map->buckets==NULL )
 		return false;
-	else {
-		const size_t hash = string_hash(key) % map->len;
-		struct HarbolVector *const bucket = &map->buckets[hash];
-		for( uindex_t i=0; i<bucket->count; i++ ) {
-			struct HarbolKeyVal **const kv = harbol_vector_get(bucket, i);
-			if( !harbol_string_cmpcstr(&(*kv)->key, key) ) {
-				harbol_kvpair_free(kv, dtor);
-				harbol_vector_del(bucket, i, NULL);
-				map->count--;
-				return true;
-			}
-		}
+	
+	__harbol_map_migrate_step(map);
+	struct HarbolKeyVal **const kv = __harbol_map_find(map, key);
+	if( kv==NULL )
 		return false;
+	else if( map->old.buckets != NULL && kv >= map->old.buckets && kv < &map->old.buckets[map->old.len] ) {
+		/* not migrated yet, the old table is never probed for free slots so a tombstone is fine. */
+		__harbol_kvpair_destroy(map->alloc, kv, dtor);
+		map->old.ctrl[kv - map->old.buckets] = HarbolMapCtrl_Deleted;
+		map->count--;
+		return true;
+	} else {
+		const size_t slot = kv - map->buckets;
+		__harbol_kvpair_destroy(map->alloc, kv, dtor);
+		/* if the slot's group still has an empty slot, no probe ever went past it so it can be emptied outright. */
+		const size_t base = slot & ~(size_t)(HARBOL_MAP_GROUP_WIDTH - 1);
+		if( __harbol_map_group_match_empty(&map->ctrl[base]) ) {
+			map->ctrl[slot] = HarbolMapCtrl_Empty;
+		} else {
+			map->ctrl[slot] = HarbolMapCtrl_Deleted;
+			map->tombs++;
+		}
+		map->count--;
+		return true;
 	}
 }
@@ -9,43 +9,96 @@ extern "C" {
 #include "../harbol_common_includes.h"
 #include "../stringobj/stringobj.h"
 #include "../vector/vector.h"
+#include "../hash/hash.h"
 
 #ifndef MAP_DEFAULT_SIZE
 #	define MAP_DEFAULT_SIZE    8
 #endif
 
+/* slots are probed in groups of control bytes, table lengths are always a power of 2 multiple of this. */
+#ifndef HARBOL_MAP_GROUP_WIDTH
+#	define HARBOL_MAP_GROUP_WIDTH    16
+#endif
+
 
+/* pairs are a single allocation with the data and key bytes stored right after the struct.
+ * 'key' points into the pair so it must never be resized or cleared on its own.
+ */
 struct HarbolKeyVal {
 	struct HarbolString key;
 	uint8_t *data;
+	size_t hash; // full hash of 'key', cached by the map that owns this pair.
 };
 
 HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_kvpair_new(const char cstr[], void *data, size_t datasize);
+
+/* 'data' is part of the pair's own block so 'dtor' gets a pointer to a temporary copy of the data pointer, like vector elements do.
+ * 'dtor' should only destroy what the data holds, freeing '*p' itself frees the middle of the pair's block.
+ * the same goes for the map & linkmap clear/free/del 'dtor's.
+ */
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_kvpair_free(struct HarbolKeyVal **kvpairref, void dtor(void**));
 
+/* pairs have to be freed with the allocator they were made with, NULL is the default heap. */
+HARBOL_EXPORT NEVER_NULL(2, 3) struct HarbolKeyVal *harbol_kvpair_new_with(const struct HarbolAllocator *alloc, const char cstr[], void *data, size_t datasize);
+HARBOL_EXPORT NEVER_NULL(2) bool harbol_kvpair_free_with(const struct HarbolAllocator *alloc, struct HarbolKeyVal **kvpairref, void dtor(void**));
+
 
+/* open-addressed table, each slot has a control byte that's either empty, deleted, or the low 7 bits of the key's hash.
+ * control bytes are scanned a group at a time so most lookups only touch a single cache line before comparing keys.
+ */
 struct HarbolMap {
-	// buckets is a vector of vectors of keyval pointers.
-	struct HarbolVector *buckets;
-	size_t len, count, datasize;
+	struct HarbolKeyVal **buckets; // flat slot array, 'ctrl' is allocated right after it.
+	uint8_t *ctrl;
+	size_t len, count, datasize, tombs;
+	
+	/* with a non-zero 'rehash_step', growing keeps the old table around and each insert, set, or delete moves 'old.step' of its slots over.
+	 * 'old.step' is at least 'rehash_step', more if that's what it takes to finish before the new table fills up.
+	 */
+	struct {
+		struct HarbolKeyVal **buckets;
+		uint8_t *ctrl;
+		size_t len, cursor, step;
+	} old;
+	size_t rehash_step;
+	uint64_t seed; // each map gets its own hash seed so key collisions can't be precomputed.
+	const struct HarbolAllocator *alloc; // tables and pairs come from here, NULL uses the default allocator.
 };
 
-#define EMPTY_HARBOL_MAP    {NULL,0,0,0}
+#define EMPTY_HARBOL_MAP    {NULL,NULL,0,0,0,0,{NULL,NULL,0,0,0},0,0,NULL}
 
 HARBOL_EXPORT struct HarbolMap *harbol_map_new(size_t datasize);
 HARBOL_EXPORT struct HarbolMap harbol_map_create(size_t datasize);
+HARBOL_EXPORT struct HarbolMap harbol_map_create_with(size_t datasize, const struct HarbolAllocator *alloc);
+/* 'dtor' gets the same temporary data pointer as 'harbol_kvpair_free', never free '*p' itself. */
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_map_clear(struct HarbolMap *map, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_map_free(struct HarbolMap **mapref, void dtor(void**));
 
 HARBOL_EXPORT NO_NULL bool harbol_map_insert(struct HarbolMap *map, const char key[], void *val);
+/* the map takes ownership of 'kv' and frees it with its own allocator,
+ * so 'kv' must come from 'harbol_kvpair_new_with' using the map's 'alloc' ('harbol_kvpair_new' if it's NULL).
+ */
 HARBOL_EXPORT NO_NULL bool harbol_map_insert_kv(struct HarbolMap *map, struct HarbolKeyVal *kv);
 
+/* find-or-insert with a single probe, returns the key's data which is zeroed if 'inserted' gets set true. */
+HARBOL_EXPORT NEVER_NULL(1, 2) void *harbol_map_entry(struct HarbolMap *map, const char key[], bool *inserted);
+HARBOL_EXPORT NEVER_NULL(1) void *harbol_map_entry_view(struct HarbolMap *map, struct HarbolStrView key, bool *inserted);
+
 HARBOL_EXPORT NO_NULL void *harbol_map_get(const struct HarbolMap *map, const char key[]);
 HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_map_get_kv(const struct HarbolMap *map, const char key[]);
 HARBOL_EXPORT NO_NULL bool harbol_map_set(struct HarbolMap *map, const char key[], void *val);
 
+/* '*_view' lookups take keys that aren't null terminated, like tokens sliced out of a source buffer. */
+HARBOL_EXPORT NO_NULL void *harbol_map_get_view(const struct HarbolMap *map, struct HarbolStrView key);
+HARBOL_EXPORT NO_NULL struct HarbolKeyVal *harbol_map_get_kv_view(const struct HarbolMap *map, struct HarbolStrView key);
+
+/* looks up 'n' keys at once so their cache misses overlap, missing keys get NULL. returns how many were found. */
+HARBOL_EXPORT NO_NULL size_t harbol_map_get_many(const struct HarbolMap *map, const char *const keys[], size_t n, void *out[]);
+
 HARBOL_EXPORT NO_NULL bool harbol_map_has_key(const struct HarbolMap *map, const char key[]);
+HARBOL_EXPORT NO_NULL bool harbol_map_has_key_view(const struct HarbolMap *map, struct HarbolStrView key);
 HARBOL_EXPORT NO_NULL bool harbol_map_rehash(struct HarbolMap *map, size_t new_len);
+HARBOL_EXPORT NO_NULL void harbol_map_set_rehash_step(struct HarbolMap *map, size_t slots);
+/* 'dtor' works like it does for 'harbol_map_clear'. */
 HARBOL_EXPORT NEVER_NULL(1, 2) bool harbol_map_del(struct HarbolMap *map, const char key[], void dtor(void**));
 /********************************************************************/
 
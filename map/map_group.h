@@ -0,0 +1,101 @@
+#ifndef HARBOL_MAP_GROUP_INCLUDED
+#	define HARBOL_MAP_GROUP_INCLUDED
+
+/* control byte & group probing helpers shared by the map flavors, not part of the public api. */
+#include "map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define HARBOL_MAP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	include <arm_neon.h>
+#	define HARBOL_MAP_NEON
+#endif
+
+#ifdef COMPILER_MSVC
+#	include <intrin.h>
+#endif
+
+
+enum {
+	HarbolMapCtrl_Empty   = 0x80,
+	HarbolMapCtrl_Deleted = 0xFE,
+};
+
+/* group match masks are one bit per control byte for SSE2 & scalar, NEON gives one nibble per byte. */
+#ifdef HARBOL_MAP_NEON
+#	define HARBOL_MAP_MASK_SHIFT    2
+#else
+#	define HARBOL_MAP_MASK_SHIFT    0
+#endif
+
+static inline size_t __harbol_map_lowest_bit(const uint64_t mask)
+{
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+	return (size_t)__builtin_ctzll(mask) >> HARBOL_MAP_MASK_SHIFT;
+#elif defined(COMPILER_MSVC) && defined(HARBOL64)
+	unsigned long i = 0;
+	_BitScanForward64(&i, mask);
+	return i >> HARBOL_MAP_MASK_SHIFT;
+#else
+	size_t i = 0;
+	while( !(mask & (1ull << i)) )
+		i++;
+	return i >> HARBOL_MAP_MASK_SHIFT;
+#endif
+}
+
+static inline uint64_t __harbol_map_group_match(const uint8_t ctrl[const static HARBOL_MAP_GROUP_WIDTH], const uint8_t h2)
+{
+#if defined(HARBOL_MAP_SSE2)
+	const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+#elif defined(HARBOL_MAP_NEON)
+	const uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2));
+	const uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+	return nibbles & 0x8888888888888888ull;
+#else
+	uint64_t mask = 0;
+	for( uindex_t i=0; i<HARBOL_MAP_GROUP_WIDTH; i++ )
+		mask |= (uint64_t)(ctrl[i]==h2) << i;
+	return mask;
+#endif
+}
+
+/* matches both empty and deleted slots, the only control bytes with the high bit set. */
+static inline uint64_t __harbol_map_group_match_free(const uint8_t ctrl[const static HARBOL_MAP_GROUP_WIDTH])
+{
+#if defined(HARBOL_MAP_SSE2)
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#elif defined(HARBOL_MAP_NEON)
+	const uint8x16_t hi = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0));
+	const uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hi), 4)), 0);
+	return nibbles & 0x8888888888888888ull;
+#else
+	uint64_t mask = 0;
+	for( uindex_t i=0; i<HARBOL_MAP_GROUP_WIDTH; i++ )
+		mask |= (uint64_t)(ctrl[i] >> 7) << i;
+	return mask;
+#endif
+}
+
+static inline uint64_t __harbol_map_group_match_empty(const uint8_t ctrl[const static HARBOL_MAP_GROUP_WIDTH])
+{
+	return __harbol_map_group_match(ctrl, HarbolMapCtrl_Empty);
+}
+
+static inline size_t __harbol_map_max_load(const size_t len)
+{
+	return len - (len >> 3);
+}
+
+static inline size_t __harbol_map_table_len(const size_t min_len, const size_t count)
+{
+	/* round up to a power of 2 number of groups that can still hold everything under the max load. */
+	size_t len = HARBOL_MAP_GROUP_WIDTH;
+	while( len < min_len || __harbol_map_max_load(len) <= count )
+		len <<= 1;
+	return len;
+}
+
+#endif /* HARBOL_MAP_GROUP_INCLUDED */
@@ -83,12 +83,12 @@ HARBOL_EXPORT HarbolDLL harbol_plugin_shared_obj(const struct HarbolPlugin *cons
 
 HARBOL_EXPORT const char *harbol_plugin_name(const struct HarbolPlugin *const plugin)
 {
-	return( plugin->name==NULL ) ? NULL : plugin->name->cstr;
+	return( plugin->name==NULL ) ? NULL : harbol_string_cstr(plugin->name);
 }
 
 HARBOL_EXPORT const char *harbol_plugin_path(const struct HarbolPlugin *plugin)
 {
-	return plugin->path.cstr;
+	return harbol_string_cstr(&plugin->path);
 }
 
 HARBOL_EXPORT void *harbol_plugin_sym(const struct HarbolPlugin *const restrict plugin, const char sym_name[restrict static 1])
@@ -98,13 +98,13 @@ HARBOL_EXPORT void *harbol_plugin_sym(const struct HarbolPlugin *const restrict
 
 HARBOL_EXPORT bool harbol_plugin_reload(struct HarbolPlugin *const plugin)
 {
-	if( plugin->path.cstr==NULL )
+	if( harbol_string_is_empty(&plugin->path) )
 		return false;
 	else {
 		if( plugin->dll != NULL )
 			MODULE_CLOSE(plugin->dll), plugin->dll=NULL;
 		
-		plugin->dll = MODULE_LOAD(plugin->path.cstr);
+		plugin->dll = MODULE_LOAD(harbol_string_cstr(&plugin->path));
 		return plugin->dll != NULL;
 	}
 }
@@ -172,7 +172,7 @@ dir_iter_loop:;
 			break;
 	}
 	tinydir_close(dir);
-	return mod->plugins.vec.count > 0;
+	return harbol_linkmap_count(&mod->plugins) > 0;
 }
 
 static NEVER_NULL(1, 2, 3) bool __recursive_scan_by_name(struct HarbolPluginMod *const restrict mod, tinydir_dir *const restrict dir, const char plugin_name[restrict static 1], HarbolPluginEvent load_cb)
@@ -204,7 +204,7 @@ dir_iter_loop:;
 			break;
 	}
 	tinydir_close(dir);
-	return mod->plugins.vec.count > 0;
+	return harbol_linkmap_count(&mod->plugins) > 0;
 }
 
 HARBOL_EXPORT struct HarbolPluginMod harbol_plugin_mod_create(const char dir[restrict static 1], void *const userdata, const bool load_plugins, HarbolPluginEvent load_cb)
@@ -257,12 +257,12 @@ HARBOL_EXPORT struct HarbolPlugin *harbol_plugin_mod_index_get_plugin(const stru
 
 HARBOL_EXPORT size_t harbol_plugin_mod_plugin_count(const struct HarbolPluginMod *const mod)
 {
-	return mod->plugins.vec.count;
+	return harbol_linkmap_count(&mod->plugins);
 }
 
 HARBOL_EXPORT const char *harbol_plugin_mod_get_dir(const struct HarbolPluginMod *const mod)
 {
-	return mod->dir.cstr;
+	return harbol_string_cstr(&mod->dir);
 }
 
 HARBOL_EXPORT void *harbol_plugin_mod_userdata(const struct HarbolPluginMod *const mod)
@@ -274,8 +274,8 @@ HARBOL_EXPORT void *harbol_plugin_mod_userdata(const struct HarbolPluginMod *con
 HARBOL_EXPORT bool harbol_plugin_mod_name_load_plugin(struct HarbolPluginMod *const restrict mod, const char plugin_name[restrict static 1], HarbolPluginEvent load_cb)
 {
 	tinydir_dir dir;
-	if( tinydir_open(&dir, mod->dir.cstr)<0 ) {
-		fprintf(stderr, "Harbol Plugin Manager Error: **** Unable to Open dir: '%s' ****\n", mod->dir.cstr);
+	if( tinydir_open(&dir, harbol_string_cstr(&mod->dir))<0 ) {
+		fprintf(stderr, "Harbol Plugin Manager Error: **** Unable to Open dir: '%s' ****\n", harbol_string_cstr(&mod->dir));
 		harbol_string_clear(&mod->dir);
 		tinydir_close(&dir);
 		return false;
@@ -314,8 +314,8 @@ HARBOL_EXPORT bool harbol_plugin_mod_index_del_plugin(struct HarbolPluginMod *co
 HARBOL_EXPORT bool harbol_plugin_mod_load_plugins(struct HarbolPluginMod *const mod, HarbolPluginEvent load_cb)
 {
 	tinydir_dir dir;
-	if( tinydir_open(&dir, mod->dir.cstr)<0 ) {
-		fprintf(stderr, "Harbol Plugin Manager Error: **** Unable to Open dir: '%s' ****\n", mod->dir.cstr);
+	if( tinydir_open(&dir, harbol_string_cstr(&mod->dir))<0 ) {
+		fprintf(stderr, "Harbol Plugin Manager Error: **** Unable to Open dir: '%s' ****\n", harbol_string_cstr(&mod->dir));
 		harbol_string_clear(&mod->dir);
 		tinydir_close(&dir);
 		return false;
@@ -326,7 +326,7 @@ HARBOL_EXPORT bool harbol_plugin_mod_load_plugins(struct HarbolPluginMod *const
 
 HARBOL_EXPORT bool harbol_plugin_mod_unload_plugins(struct HarbolPluginMod *const mod, HarbolPluginEvent unload_cb)
 {
-	for( uindex_t i=0; i<mod->plugins.vec.count; i++ ) {
+	for( uindex_t i=0; i<harbol_linkmap_count(&mod->plugins); i++ ) {
 		struct HarbolPlugin *plugin = harbol_linkmap_index_get(&mod->plugins, i);
 		if( unload_cb != NULL )
 			unload_cb(mod, plugin);
@@ -338,7 +338,7 @@ HARBOL_EXPORT bool harbol_plugin_mod_unload_plugins(struct HarbolPluginMod *cons
 
 HARBOL_EXPORT bool harbol_plugin_mod_reload_plugins(struct HarbolPluginMod *const mod, HarbolPluginEvent prereload_cb, HarbolPluginEvent postreload_cb)
 {
-	for( uindex_t i=0; i<mod->plugins.vec.count; i++ ) {
+	for( uindex_t i=0; i<harbol_linkmap_count(&mod->plugins); i++ ) {
 		struct HarbolPlugin *plugin = harbol_linkmap_index_get(&mod->plugins, i);
 		if( prereload_cb != NULL )
 			prereload_cb(mod, plugin);
@@ -0,0 +1,187 @@
+#include "strbuilder.h"
+
+#ifdef OS_WINDOWS
+#	define HARBOL_LIB
+#endif
+
+
+HARBOL_EXPORT struct HarbolStrBuilder *harbol_strbuilder_new(void)
+{
+	struct HarbolStrBuilder *builder = harbol_alloc(1, sizeof *builder);
+	if( builder != NULL )
+		*builder = harbol_strbuilder_create();
+	return builder;
+}
+
+HARBOL_EXPORT struct HarbolStrBuilder harbol_strbuilder_create(void)
+{
+	return harbol_strbuilder_create_with(NULL);
+}
+
+HARBOL_EXPORT struct HarbolStrBuilder harbol_strbuilder_create_with(const struct HarbolAllocator *const alloc)
+{
+	struct HarbolStrBuilder builder = EMPTY_HARBOL_STRBUILDER;
+	builder.alloc = alloc;
+	return builder;
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_clear(struct HarbolStrBuilder *const builder)
+{
+	const struct HarbolAllocator *const alloc = builder->alloc;
+	for( struct HarbolStrChunk *chunk = builder->head; chunk != NULL; ) {
+		struct HarbolStrChunk *const next = chunk->next;
+		harbol_free_with(alloc, chunk);
+		chunk = next;
+	}
+	*builder = harbol_strbuilder_create_with(alloc);
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_free(struct HarbolStrBuilder **const builderref)
+{
+	if( *builderref==NULL )
+		return false;
+	else {
+		const bool res = harbol_strbuilder_clear(*builderref);
+		harbol_free(*builderref), *builderref=NULL;
+		return res && *builderref==NULL;
+	}
+}
+
+static inline NO_NULL size_t __harbol_strbuilder_room(const struct HarbolStrBuilder *const builder)
+{
+	return( builder->tail==NULL ) ? 0 : builder->tail->cap - builder->tail->len;
+}
+
+/* links a fresh chunk that holds at least 'needed' bytes, the extra byte is so 'vsnprintf' always has room for its terminator. */
+static NO_NULL struct HarbolStrChunk *__harbol_strbuilder_add_chunk(struct HarbolStrBuilder *const builder, const size_t needed)
+{
+	const size_t cap = ( needed > HARBOL_STRBUILDER_CHUNK ) ? needed : HARBOL_STRBUILDER_CHUNK;
+	struct HarbolStrChunk *const chunk = harbol_alloc_with(builder->alloc, 1, sizeof *chunk + cap + 1);
+	if( chunk==NULL )
+		return NULL;
+	
+	chunk->next = NULL;
+	chunk->len = 0;
+	chunk->cap = cap;
+	if( builder->tail==NULL )
+		builder->head = chunk;
+	else builder->tail->next = chunk;
+	builder->tail = chunk;
+	return chunk;
+}
+
+static NO_NULL bool __harbol_strbuilder_append(struct HarbolStrBuilder *const builder, const char data[const], const size_t len)
+{
+	const size_t room = __harbol_strbuilder_room(builder);
+	const size_t head = ( len < room ) ? len : room;
+	if( head > 0 ) {
+		memcpy(&builder->tail->data[builder->tail->len], data, head);
+		builder->tail->len += head;
+		builder->len += head;
+	}
+	
+	const size_t rest = len - head;
+	if( rest==0 )
+		return true;
+	
+	struct HarbolStrChunk *const chunk = __harbol_strbuilder_add_chunk(builder, rest);
+	if( chunk==NULL )
+		return false;
+	
+	memcpy(chunk->data, &data[head], rest);
+	chunk->len = rest;
+	builder->len += rest;
+	return true;
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_add_char(struct HarbolStrBuilder *const builder, const char c)
+{
+	if( __harbol_strbuilder_room(builder)==0 && __harbol_strbuilder_add_chunk(builder, 1)==NULL )
+		return false;
+	else {
+		builder->tail->data[builder->tail->len++] = c;
+		builder->len++;
+		return true;
+	}
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_add_cstr(struct HarbolStrBuilder *const restrict builder, const char cstr[restrict static 1])
+{
+	return __harbol_strbuilder_append(builder, cstr, strlen(cstr));
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_add_view(struct HarbolStrBuilder *const builder, const struct HarbolStrView view)
+{
+	return( view.len==0 ) ? true : __harbol_strbuilder_append(builder, view.ptr, view.len);
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_add_str(struct HarbolStrBuilder *const restrict builder, const struct HarbolString *const restrict str)
+{
+	return __harbol_strbuilder_append(builder, harbol_string_cstr(str), harbol_string_len(str));
+}
+
+HARBOL_EXPORT int32_t harbol_strbuilder_add_format(struct HarbolStrBuilder *const restrict builder, const char fmt[restrict static 1], ...)
+{
+	va_list ap, st;
+	va_start(ap, fmt);
+	va_copy(st, ap);
+	
+	/* try formatting straight into the tail, most formats are short enough to fit. */
+	const size_t room = __harbol_strbuilder_room(builder);
+	char c = 0;
+	char *const dest = ( builder->tail==NULL ) ? &c : &builder->tail->data[builder->tail->len];
+	const int32_t size = vsnprintf(dest, room + 1, fmt, ap);
+	va_end(ap);
+	
+	if( size < 0 ) {
+		va_end(st);
+		return -1;
+	} else if( size==0 ) {
+		/* nothing to add, a fresh builder doesn't even have a tail yet. */
+		va_end(st);
+		return 0;
+	} else if( (size_t)size <= room ) {
+		va_end(st);
+		builder->tail->len += size;
+		builder->len += size;
+		return size;
+	}
+	
+	/* too big, whatever got written into the tail's spare room is just left behind. */
+	struct HarbolStrChunk *const chunk = __harbol_strbuilder_add_chunk(builder, size);
+	if( chunk==NULL ) {
+		va_end(st);
+		return -1;
+	} else {
+		const int32_t result = vsnprintf(chunk->data, size + 1, fmt, st);
+		va_end(st);
+		chunk->len = size;
+		builder->len += size;
+		return result;
+	}
+}
+
+HARBOL_EXPORT size_t harbol_strbuilder_len(const struct HarbolStrBuilder *const builder)
+{
+	return builder->len;
+}
+
+HARBOL_EXPORT struct HarbolString harbol_strbuilder_to_str(const struct HarbolStrBuilder *const builder)
+{
+	struct HarbolString str = harbol_string_create_with("", builder->alloc);
+	if( !harbol_string_reserve(&str, builder->len) )
+		return str;
+	
+	for( const struct HarbolStrChunk *chunk = builder->head; chunk != NULL; chunk = chunk->next )
+		harbol_string_add_view(&str, (struct HarbolStrView){ chunk->data, chunk->len });
+	return str;
+}
+
+HARBOL_EXPORT bool harbol_strbuilder_write_file(const struct HarbolStrBuilder *const restrict builder, FILE *const restrict file)
+{
+	for( const struct HarbolStrChunk *chunk = builder->head; chunk != NULL; chunk = chunk->next )
+		if( fwrite(chunk->data, sizeof chunk->data[0], chunk->len, file) != chunk->len )
+			return false;
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef HARBOL_STRBUILDER_INCLUDED
+#	define HARBOL_STRBUILDER_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stringobj.h"
+
+#ifndef HARBOL_STRBUILDER_CHUNK
+#	define HARBOL_STRBUILDER_CHUNK    4096
+#endif
+
+
+/* appends land in the tail chunk, a full chunk is never moved or copied again until the builder is flattened or written out. */
+struct HarbolStrChunk {
+	struct HarbolStrChunk *next;
+	size_t len, cap;
+	char data[];
+};
+
+struct HarbolStrBuilder {
+	struct HarbolStrChunk *head, *tail;
+	size_t len;
+	const struct HarbolAllocator *alloc;
+};
+
+#define EMPTY_HARBOL_STRBUILDER    {NULL,NULL,0,NULL}
+
+HARBOL_EXPORT struct HarbolStrBuilder *harbol_strbuilder_new(void);
+HARBOL_EXPORT struct HarbolStrBuilder harbol_strbuilder_create(void);
+HARBOL_EXPORT struct HarbolStrBuilder harbol_strbuilder_create_with(const struct HarbolAllocator *alloc);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_clear(struct HarbolStrBuilder *builder);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_free(struct HarbolStrBuilder **builderref);
+
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_add_char(struct HarbolStrBuilder *builder, char chr);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_add_cstr(struct HarbolStrBuilder *builder, const char cstr[]);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_add_view(struct HarbolStrBuilder *builder, struct HarbolStrView view);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_add_str(struct HarbolStrBuilder *builder, const struct HarbolString *str);
+HARBOL_EXPORT NEVER_NULL(1, 2) int32_t harbol_strbuilder_add_format(struct HarbolStrBuilder *builder, const char fmt[], ...);
+
+HARBOL_EXPORT NO_NULL size_t harbol_strbuilder_len(const struct HarbolStrBuilder *builder);
+
+/* both walk the chunks once, 'to_str' allocates the whole result up front with the builder's allocator. */
+HARBOL_EXPORT NO_NULL struct HarbolString harbol_strbuilder_to_str(const struct HarbolStrBuilder *builder);
+HARBOL_EXPORT NO_NULL bool harbol_strbuilder_write_file(const struct HarbolStrBuilder *builder, FILE *file);
+/********************************************************************/
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARBOL_STRBUILDER_INCLUDED */
@@ -1,42 +1,77 @@
-#include "stringobj.h"
+#include "stringobj_simd.h"
 
 #ifdef OS_WINDOWS
 #	define HARBOL_LIB
 #endif
 
-#include <ctype.h>
+static inline NO_NULL size_t __harbol_string_heap_cap(const struct HarbolString *const string)
+{
+	size_t cap = 0;
+	for( size_t i=sizeof string->buf.heap.cap - 1; i-- > 0; )
+		cap = (cap << 8) | string->buf.heap.cap[i];
+	return cap;
+}
 
-static NO_NULL bool __harbol_resize_string(struct HarbolString *const string, const size_t new_size)
+static inline NO_NULL void __harbol_string_set_heap(struct HarbolString *const string, char *const cstr, const size_t len, size_t cap)
 {
-	const size_t old_size = string->len;
-	// check if we're reducing or increasing memory.
-	// as realloc is exponentially faster when we're reducing memory.
-	const bool increasing_mem = (old_size <= new_size);
-	if( increasing_mem ) {
-		char *newstr = harbol_alloc(new_size + 1, sizeof *newstr);
-		if( newstr==NULL )
-			return false;
-		else {
-			string->len = new_size;
-			if( string->cstr != NULL ) {
-				memcpy(newstr, string->cstr, old_size);
-				harbol_free(string->cstr), string->cstr=NULL;
-			}
-			string->cstr = newstr;
-			return true;
-		}
+	string->buf.heap.cstr = cstr;
+	string->buf.heap.len = len;
+	for( size_t i=0; i < sizeof string->buf.heap.cap - 1; i++, cap >>= 8 )
+		string->buf.heap.cap[i] = cap & 0xFF;
+	string->buf.heap.cap[sizeof string->buf.heap.cap - 1] = HARBOL_STRING_HEAP_TAG;
+}
+
+/* sets the length and terminates the string, the buffer has to be big enough already. */
+static inline NO_NULL void __harbol_string_set_len(struct HarbolString *const string, const size_t len)
+{
+	if( harbol_string_is_heap(string) ) {
+		string->buf.heap.len = len;
+		string->buf.heap.cstr[len] = '\0';
 	} else {
-		string->cstr = harbol_realloc(string->cstr, new_size * sizeof *string->cstr + 1);
-		if( string->cstr==NULL )
-			return false;
-		else {
-			string->len = new_size;
-			string->cstr[string->len] = '\0';
-			return true;
-		}
+		string->buf.sso[len] = '\0';
+		string->buf.sso[HARBOL_STRING_SSO_SIZE - 1] = (char)len;
 	}
 }
 
+/* sets the length, the buffer only ever grows. */
+static NO_NULL bool __harbol_resize_string(struct HarbolString *const string, const size_t new_size)
+{
+	if( !harbol_string_reserve(string, new_size) )
+		return false;
+	else {
+		__harbol_string_set_len(string, new_size);
+		return true;
+	}
+}
+
+/* makes room for 'extra' more chars, growing geometrically so appends are amortized O(1). */
+static inline NO_NULL bool __harbol_string_grow(struct HarbolString *const string, const size_t extra)
+{
+	const size_t cap = harbol_string_cap(string);
+	const size_t needed = harbol_string_len(string) + extra;
+	return( needed <= cap ) ? true : harbol_string_reserve(string, harbol_grow_len(cap, needed));
+}
+
+/* a NULL 'cstr' appends the string to itself. */
+static NEVER_NULL(1) bool __harbol_string_append(struct HarbolString *const string, const char *const cstr, const size_t len)
+{
+	if( !__harbol_string_grow(string, len) )
+		return false;
+	else {
+		const size_t old_len = harbol_string_len(string);
+		char *const buf = harbol_string_cstr(string);
+		memcpy(&buf[old_len], (cstr==NULL) ? buf : cstr, len);
+		__harbol_string_set_len(string, old_len + len);
+		return true;
+	}
+}
+
+/* chars that are safe to write to, borrowed chars get copied out first. */
+static inline NO_NULL char *__harbol_string_mut(struct HarbolString *const string)
+{
+	return harbol_string_reserve(string, harbol_string_len(string)) ? harbol_string_cstr(string) : NULL;
+}
+
 
 HARBOL_EXPORT struct HarbolString *harbol_string_new(const char cstr[restrict])
 {
@@ -47,17 +82,32 @@ HARBOL_EXPORT struct HarbolString *harbol_string_new(const char cstr[restrict])
 }
 
 HARBOL_EXPORT struct HarbolString harbol_string_create(const char cstr[restrict])
+{
+	return harbol_string_create_with(cstr, NULL);
+}
+
+HARBOL_EXPORT struct HarbolString harbol_string_create_with(const char cstr[restrict], const struct HarbolAllocator *const alloc)
 {
 	struct HarbolString string = EMPTY_HARBOL_STRING;
+	string.alloc = alloc;
 	harbol_string_copy_cstr(&string, cstr);
 	return string;
 }
 
+HARBOL_EXPORT struct HarbolString harbol_string_borrow(const char cstr[restrict static 1], const size_t len)
+{
+	struct HarbolString string = EMPTY_HARBOL_STRING;
+	__harbol_string_set_heap(&string, (char *)cstr, len, 0);
+	return string;
+}
+
 HARBOL_EXPORT bool harbol_string_clear(struct HarbolString *const string)
 {
-	if( string->cstr != NULL )
-		harbol_free(string->cstr), string->cstr=NULL;
+	const struct HarbolAllocator *const alloc = string->alloc;
+	if( harbol_string_is_heap(string) && __harbol_string_heap_cap(string) > 0 )
+		harbol_free_with(alloc, string->buf.heap.cstr);
 	*string = (struct HarbolString)EMPTY_HARBOL_STRING;
+	string->alloc = alloc;
 	return true;
 }
 
@@ -74,68 +124,78 @@ HARBOL_EXPORT bool harbol_string_free(struct HarbolString **const stringref)
 
 HARBOL_EXPORT bool harbol_string_add_char(struct HarbolString *const string, const char c)
 {
-	const bool resize_res = __harbol_resize_string(string, string->len + 1);
-	if( !resize_res )
+	if( !__harbol_string_grow(string, 1) )
 		return false;
 	else {
-		string->cstr[string->len-1] = c;
+		const size_t len = harbol_string_len(string);
+		harbol_string_cstr(string)[len] = c;
+		__harbol_string_set_len(string, len + 1);
 		return true;
 	}
 }
 
 HARBOL_EXPORT bool harbol_string_add_str(struct HarbolString *const stringA, const struct HarbolString *const stringB)
 {
-	if( stringB->cstr==NULL )
-		return false;
-	else {
-		const bool resize_res = __harbol_resize_string(stringA, stringA->len + stringB->len);
-		if( !resize_res )
-			return false;
-		else {
-			strncat(stringA->cstr, stringB->cstr, stringB->len);
-			return true;
-		}
-	}
+	/* 'stringB' can be 'stringA' so grab its length before growing. */
+	const size_t len = harbol_string_len(stringB);
+	return __harbol_string_append(stringA, (stringA==stringB) ? NULL : harbol_string_cstr(stringB), len);
 }
 
 HARBOL_EXPORT bool harbol_string_add_cstr(struct HarbolString *const restrict string, const char cstr[restrict])
 {
-	if( cstr==NULL )
-		return false;
-	else {
-		const size_t cstr_len = strlen(cstr);
-		const bool resize_res = __harbol_resize_string(string, string->len + cstr_len);
-		if( !resize_res )
-			return false;
-		else {
-			strncat(string->cstr, cstr, cstr_len);
-			return true;
-		}
-	}
+	return( cstr==NULL ) ? false : __harbol_string_append(string, cstr, strlen(cstr));
 }
 
-HARBOL_EXPORT inline char *harbol_string_cstr(const struct HarbolString *const string)
+HARBOL_EXPORT bool harbol_string_add_view(struct HarbolString *const string, const struct HarbolStrView view)
 {
-	return string->cstr;
+	return( view.len==0 ) ? true : __harbol_string_append(string, view.ptr, view.len);
 }
 
-HARBOL_EXPORT inline size_t harbol_string_len(const struct HarbolString *const string)
+HARBOL_EXPORT size_t harbol_string_cap(const struct HarbolString *const string)
 {
-	return string->len;
+	return harbol_string_is_heap(string) ? __harbol_string_heap_cap(string) : HARBOL_STRING_SSO_CAP;
+}
+
+HARBOL_EXPORT bool harbol_string_reserve(struct HarbolString *const string, const size_t cap)
+{
+	const bool heap = harbol_string_is_heap(string);
+	const size_t old_cap = heap ? __harbol_string_heap_cap(string) : HARBOL_STRING_SSO_CAP;
+	/* borrowed chars have a 0 capacity so they always get copied out here. */
+	if( cap <= old_cap )
+		return true;
+	else if( heap && old_cap > 0 ) {
+		char *const newstr = harbol_realloc_with(string->alloc, string->buf.heap.cstr, old_cap + 1, cap + 1);
+		if( newstr==NULL )
+			return false;
+		else {
+			__harbol_string_set_heap(string, newstr, string->buf.heap.len, cap);
+			return true;
+		}
+	} else {
+		const size_t len = harbol_string_len(string);
+		char *const newstr = harbol_alloc_with(string->alloc, cap + 1, sizeof *newstr);
+		if( newstr==NULL )
+			return false;
+		else {
+			memcpy(newstr, harbol_string_cstr(string), len);
+			newstr[len] = '\0';
+			__harbol_string_set_heap(string, newstr, len, cap);
+			return true;
+		}
+	}
 }
 
 HARBOL_EXPORT bool harbol_string_copy_str(struct HarbolString *const stringA, const struct HarbolString *const stringB)
 {
-	if( stringB->cstr==NULL )
-		return false;
-	else if( stringA==stringB )
+	if( stringA==stringB )
 		return true;
 	else {
-		const bool resize_res = __harbol_resize_string(stringA, stringB->len);
+		const size_t len = harbol_string_len(stringB);
+		const bool resize_res = __harbol_resize_string(stringA, len);
 		if( !resize_res )
 			return false;
 		else {
-			strncpy(stringA->cstr, stringB->cstr, stringB->len);
+			memcpy(harbol_string_cstr(stringA), harbol_string_cstr(stringB), len);
 			return true;
 		}
 	}
@@ -151,12 +211,24 @@ HARBOL_EXPORT bool harbol_string_copy_cstr(struct HarbolString *const restrict s
 		if( !resize_res )
 			return false;
 		else {
-			strncpy(string->cstr, cstr, string->len);
+			memcpy(harbol_string_cstr(string), cstr, cstr_len);
 			return true;
 		}
 	}
 }
 
+HARBOL_EXPORT bool harbol_string_copy_view(struct HarbolString *const string, const struct HarbolStrView view)
+{
+	const bool resize_res = __harbol_resize_string(string, view.len);
+	if( !resize_res )
+		return false;
+	else {
+		if( view.len > 0 )
+			memmove(harbol_string_cstr(string), view.ptr, view.len);
+		return true;
+	}
+}
+
 HARBOL_EXPORT int32_t harbol_string_format(struct HarbolString *const restrict string, const char fmt[restrict static 1], ...)
 {
 	va_list ap, st;
@@ -176,7 +248,7 @@ HARBOL_EXPORT int32_t harbol_string_format(struct HarbolString *const restrict s
 		return -1;
 	} else {
 		/* vsnprintf always checks n-1 so gotta increase len a bit to accomodate. */
-		const int32_t result = vsnprintf(string->cstr, string->len+1, fmt, st);
+		const int32_t result = vsnprintf(harbol_string_cstr(string), size+1, fmt, st);
 		va_end(st);
 		return result;
 	}
@@ -192,13 +264,13 @@ HARBOL_EXPORT int32_t harbol_string_add_format(struct HarbolString *const restri
 	const int32_t size = vsnprintf(&c, 1, fmt, ap);
 	va_end(ap);
 	
-	const size_t old_size = str->len;
-	const bool resize_res = __harbol_resize_string(str, size + old_size);
+	const size_t old_size = harbol_string_len(str);
+	const bool resize_res = __harbol_string_grow(str, size) && __harbol_resize_string(str, size + old_size);
 	if( !resize_res ) {
 		va_end(st);
 		return -1;
 	} else {
-		const int32_t result = vsnprintf(&str->cstr[old_size], str->len-old_size+1, fmt, st);
+		const int32_t result = vsnprintf(&harbol_string_cstr(str)[old_size], size+1, fmt, st);
 		va_end(st);
 		return result;
 	}
@@ -208,42 +280,76 @@ HARBOL_EXPORT int32_t harbol_string_scan(struct HarbolString *const restrict str
 {
 	va_list args;
 	va_start(args, fmt);
-	const int32_t result = vsscanf(string->cstr, fmt, args);
+	const int32_t result = vsscanf(harbol_string_cstr(string), fmt, args);
 	va_end(args);
 	return result;
 }
 
 HARBOL_EXPORT int32_t harbol_string_cmpcstr(const struct HarbolString *const restrict string, const char cstr[restrict])
 {
-	if( cstr==NULL || string->cstr==NULL )
+	if( cstr==NULL )
 		return -1;
 	else {
 		const size_t cstr_len = strlen(cstr);
-		return strncmp(cstr, string->cstr, (string->len > cstr_len) ? string->len : cstr_len);
+		const size_t len = harbol_string_len(string);
+		return strncmp(cstr, harbol_string_cstr(string), (len > cstr_len) ? len : cstr_len);
 	}
 }
 
 HARBOL_EXPORT int32_t harbol_string_cmpstr(const struct HarbolString *const restrict stringA, const struct HarbolString *const restrict stringB)
 {
-	return( stringA->cstr==NULL || stringB->cstr==NULL ) ? -1 : strncmp(stringA->cstr, stringB->cstr, stringA->len > stringB->len ? stringA->len : stringB->len);
+	const size_t lenA = harbol_string_len(stringA), lenB = harbol_string_len(stringB);
+	return strncmp(harbol_string_cstr(stringA), harbol_string_cstr(stringB), lenA > lenB ? lenA : lenB);
+}
+
+HARBOL_EXPORT int32_t harbol_string_cmpview(const struct HarbolString *const string, const struct HarbolStrView view)
+{
+	return harbol_strview_cmp(harbol_string_view(string), view);
+}
+
+HARBOL_EXPORT int32_t harbol_strview_cmp(const struct HarbolStrView a, const struct HarbolStrView b)
+{
+	const size_t len = (a.len < b.len) ? a.len : b.len;
+	const int32_t res = (len==0) ? 0 : memcmp(a.ptr, b.ptr, len);
+	return( res != 0 ) ? res : (a.len > b.len) - (a.len < b.len);
 }
 
 HARBOL_EXPORT bool harbol_string_is_empty(const struct HarbolString *const string)
 {
-	return( string->cstr==NULL || string->len==0 || string->cstr[0]==0 );
+	return( harbol_string_len(string)==0 || harbol_string_cstr(string)[0]==0 );
+}
+
+/* pipes & other streams that can't be sized get read in chunks until EOF. */
+static NO_NULL bool __harbol_string_read_stream(struct HarbolString *const string, FILE *const file)
+{
+	size_t len = 0;
+	for( ;; ) {
+		const size_t cap = harbol_string_cap(string);
+		if( len + BUFSIZ > cap && !harbol_string_reserve(string, harbol_grow_len(cap, len + BUFSIZ)) )
+			return false;
+		
+		const size_t want = harbol_string_cap(string) - len;
+		const size_t got = fread(&harbol_string_cstr(string)[len], sizeof(char), want, file);
+		len += got;
+		if( got < want )
+			break;
+	}
+	__harbol_string_set_len(string, len);
+	return len > 0 && !ferror(file);
 }
 
 HARBOL_EXPORT bool harbol_string_read_file(struct HarbolString *const string, FILE *const file)
 {
 	const ssize_t filesize = get_file_size(file);
 	if( filesize<=0 )
-		return false;
+		return __harbol_string_read_stream(string, file);
 	else {
 		const bool resize_res = __harbol_resize_string(string, filesize);
 		if( !resize_res )
 			return false;
 		else {
-			string->len = fread(string->cstr, sizeof *string->cstr, filesize, file);
+			char *const buf = harbol_string_cstr(string);
+			__harbol_string_set_len(string, fread(buf, sizeof *buf, filesize, file));
 			return true;
 		}
 	}
@@ -251,69 +357,89 @@ HARBOL_EXPORT bool harbol_string_read_file(struct HarbolString *const string, FI
 
 HARBOL_EXPORT bool harbol_string_replace(struct HarbolString *const string, const char to_replace, const char with)
 {
-	if( string->cstr==NULL || to_replace==0 || with==0 )
+	char *const buf = (to_replace==0 || with==0) ? NULL : __harbol_string_mut(string);
+	if( buf==NULL )
 		return false;
 	else {
-		for( char *i=string->cstr; *i; i++ )
-			if( *i==to_replace )
-				*i = with;
+		__harbol_string_replace_kernel(buf, harbol_string_len(string), to_replace, with);
 		return true;
 	}
 }
 
 HARBOL_EXPORT size_t harbol_string_count(const struct HarbolString *const string, const char occurrence)
 {
-	if( string->cstr==NULL )
-		return 0;
+	return __harbol_string_count_kernel(harbol_string_cstr(string), harbol_string_len(string), occurrence);
+}
+
+HARBOL_EXPORT index_t harbol_string_find(const struct HarbolString *const string, const struct HarbolStrView needle, const size_t start)
+{
+	const size_t len = harbol_string_len(string);
+	if( start > len || needle.len > len - start )
+		return -1;
+	else if( needle.len==0 )
+		return (index_t)start;
 	else {
-		size_t counts = 0;
-		for( char *i=string->cstr; *i; i++ )
-			if( *i==occurrence )
-				++counts;
-		return counts;
+		const index_t found = __harbol_string_find_kernel(&harbol_string_cstr(string)[start], len - start, needle.ptr, needle.len);
+		return( found<0 ) ? -1 : found + (index_t)start;
+	}
+}
+
+HARBOL_EXPORT index_t harbol_string_rfind(const struct HarbolString *const string, const struct HarbolStrView needle, size_t end)
+{
+	const size_t len = harbol_string_len(string);
+	if( end > len )
+		end = len;
+	
+	if( needle.len > end )
+		return -1;
+	else if( needle.len==0 )
+		return (index_t)end;
+	else return __harbol_string_rfind_kernel(harbol_string_cstr(string), end, needle.ptr, needle.len);
+}
+
+HARBOL_EXPORT size_t harbol_string_find_all(const struct HarbolString *const string, const struct HarbolStrView needle, size_t out[const], const size_t out_len)
+{
+	if( needle.len==0 )
+		return 0;
+	
+	size_t matches = 0;
+	for( index_t at = harbol_string_find(string, needle, 0); at >= 0; at = harbol_string_find(string, needle, (size_t)at + needle.len) ) {
+		if( matches < out_len )
+			out[matches] = (size_t)at;
+		matches++;
 	}
+	return matches;
 }
 
 HARBOL_EXPORT bool harbol_string_upper(struct HarbolString *const string)
 {
-	if( string->cstr==NULL )
+	char *const buf = __harbol_string_mut(string);
+	if( buf==NULL )
 		return false;
 	else {
-		for( char *i=string->cstr; *i; i++ )
-			if( islower(*i) )
-				*i=toupper(*i);
+		__harbol_string_flip_case_kernel(buf, harbol_string_len(string), 'a');
 		return true;
 	}
 }
 
 HARBOL_EXPORT bool harbol_string_lower(struct HarbolString *const string)
 {
-	if( string->cstr==NULL )
+	char *const buf = __harbol_string_mut(string);
+	if( buf==NULL )
 		return false;
 	else {
-		for( char *i=string->cstr; *i; i++ )
-			if( isupper(*i) )
-				*i=tolower(*i);
+		__harbol_string_flip_case_kernel(buf, harbol_string_len(string), 'A');
 		return true;
 	}
 }
 
 HARBOL_EXPORT bool harbol_string_reverse(struct HarbolString *const string)
 {
-	if( string->cstr==NULL )
+	char *const buf = __harbol_string_mut(string);
+	if( buf==NULL )
 		return false;
 	else {
-		char *buf = string->cstr;
-		const size_t len = string->len / 2;
-		for( uindex_t i=0, n=string->len-1; i<len; i++, n-- ) {
-			if( buf[n]==buf[i] )
-				continue;
-			else {
-				buf[n] ^= buf[i];
-				buf[i] ^= buf[n];
-				buf[n] ^= buf[i];
-			}
-		}
+		__harbol_string_reverse_kernel(buf, harbol_string_len(string));
 		return true;
 	}
 }
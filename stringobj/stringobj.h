@@ -8,26 +8,90 @@ extern "C" {
 #include "../harbol_common_defines.h"
 #include "../harbol_common_includes.h"
 
+/* strings of up to 'HARBOL_STRING_SSO_CAP' chars are stored inline in the struct, longer ones go on the heap.
+ * the last byte of 'buf' tells them apart: inline strings keep their length there, heap strings set it to 'HARBOL_STRING_HEAP_TAG'.
+ * use 'harbol_string_cstr' and 'harbol_string_len' instead of reading 'buf' directly.
+ */
+#define HARBOL_STRING_SSO_SIZE    (sizeof(char *) + sizeof(size_t) + sizeof(uint64_t))
+#define HARBOL_STRING_SSO_CAP     (HARBOL_STRING_SSO_SIZE - 2)
+#define HARBOL_STRING_HEAP_TAG    0xFF
+
 struct HarbolString {
-	char *cstr;
+	union {
+		struct {
+			char *cstr;
+			size_t len;
+			/* capacity as 7 little-endian bytes so the last byte is free for the tag.
+			 * a capacity of 0 means 'cstr' is borrowed and never freed.
+			 */
+			uint8_t cap[sizeof(uint64_t)];
+		} heap;
+		char sso[HARBOL_STRING_SSO_SIZE];
+	} buf;
+	const struct HarbolAllocator *alloc; // NULL uses the default allocator.
+};
+
+/* all zeroes is an empty inline string. */
+#define EMPTY_HARBOL_STRING    { {{NULL,0,{0}}}, NULL }
+
+static inline NO_NULL bool harbol_string_is_heap(const struct HarbolString *const str)
+{
+	return (uint8_t)str->buf.sso[HARBOL_STRING_SSO_SIZE - 1]==HARBOL_STRING_HEAP_TAG;
+}
+
+static inline NO_NULL char *harbol_string_cstr(const struct HarbolString *const str)
+{
+	return harbol_string_is_heap(str) ? str->buf.heap.cstr : (char *)str->buf.sso;
+}
+
+static inline NO_NULL size_t harbol_string_len(const struct HarbolString *const str)
+{
+	return harbol_string_is_heap(str) ? str->buf.heap.len : (uint8_t)str->buf.sso[HARBOL_STRING_SSO_SIZE - 1];
+}
+
+
+/* non-owning slice of chars that isn't null terminated, it must not outlive what it points into. */
+struct HarbolStrView {
+	const char *ptr;
 	size_t len;
 };
 
-#define EMPTY_HARBOL_STRING    { NULL,0 }
+#define EMPTY_HARBOL_STRVIEW    {NULL,0}
+
+static inline NO_NULL struct HarbolStrView harbol_strview(const char cstr[])
+{
+	return (struct HarbolStrView){ cstr, strlen(cstr) };
+}
+
+static inline NO_NULL struct HarbolStrView harbol_string_view(const struct HarbolString *const str)
+{
+	return (struct HarbolStrView){ harbol_string_cstr(str), harbol_string_len(str) };
+}
+
+/* orders like 'strcmp' would if both views were null terminated. */
+HARBOL_EXPORT int32_t harbol_strview_cmp(struct HarbolStrView a, struct HarbolStrView b);
 
 
 HARBOL_EXPORT struct HarbolString *harbol_string_new(const char cstr[]);
 HARBOL_EXPORT struct HarbolString harbol_string_create(const char cstr[]);
+HARBOL_EXPORT struct HarbolString harbol_string_create_with(const char cstr[], const struct HarbolAllocator *alloc);
+
+/* wraps chars the string doesn't own, like a map key inside its pair. 'cstr[len]' has to be a null terminator.
+ * clearing a borrowed string only forgets the pointer and the first write copies the chars out.
+ */
+HARBOL_EXPORT NO_NULL struct HarbolString harbol_string_borrow(const char cstr[], size_t len);
 
 HARBOL_EXPORT NO_NULL bool harbol_string_clear(struct HarbolString *str);
 HARBOL_EXPORT NO_NULL bool harbol_string_free(struct HarbolString **strref);
 
-HARBOL_EXPORT NO_NULL char *harbol_string_cstr(const struct HarbolString *str);
-HARBOL_EXPORT NO_NULL size_t harbol_string_len(const struct HarbolString *str);
+HARBOL_EXPORT NO_NULL size_t harbol_string_cap(const struct HarbolString *str);
+HARBOL_EXPORT NO_NULL bool harbol_string_reserve(struct HarbolString *str, size_t cap);
 
 HARBOL_EXPORT NO_NULL bool harbol_string_add_char(struct HarbolString *str, char chr);
 HARBOL_EXPORT NO_NULL bool harbol_string_add_str(struct HarbolString *strA, const struct HarbolString *strB) ;
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_string_add_cstr(struct HarbolString *str, const char cstr[]);
+/* 'view' can't point into 'str' itself since appending might move the chars. */
+HARBOL_EXPORT NO_NULL bool harbol_string_add_view(struct HarbolString *str, struct HarbolStrView view);
 
 #ifdef C11
 #	define harbol_string_add(str, val)  _Generic((val)+0, \
@@ -41,6 +105,7 @@ HARBOL_EXPORT NEVER_NULL(1) bool harbol_string_add_cstr(struct HarbolString *str
 
 HARBOL_EXPORT NO_NULL bool harbol_string_copy_str(struct HarbolString *strA, const struct HarbolString *strB);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_string_copy_cstr(struct HarbolString *str, const char cstr[]);
+HARBOL_EXPORT NO_NULL bool harbol_string_copy_view(struct HarbolString *str, struct HarbolStrView view);
 
 #ifdef C11
 #	define harbol_string_copy(str, val) _Generic((val)+0, \
@@ -57,6 +122,7 @@ HARBOL_EXPORT NEVER_NULL(1, 2) int32_t harbol_string_scan(struct HarbolString *s
 
 HARBOL_EXPORT NEVER_NULL(1) int32_t harbol_string_cmpcstr(const struct HarbolString *str, const char cstr[]);
 HARBOL_EXPORT NO_NULL int32_t harbol_string_cmpstr(const struct HarbolString *strA, const struct HarbolString *strB);
+HARBOL_EXPORT NO_NULL int32_t harbol_string_cmpview(const struct HarbolString *str, struct HarbolStrView view);
 
 #ifdef C11
 #	define harbol_string_cmp(str, val)  _Generic((val)+0, \
@@ -70,9 +136,20 @@ HARBOL_EXPORT NO_NULL int32_t harbol_string_cmpstr(const struct HarbolString *st
 HARBOL_EXPORT NO_NULL bool harbol_string_is_empty(const struct HarbolString *str);
 
 HARBOL_EXPORT NO_NULL bool harbol_string_read_file(struct HarbolString *str, FILE *file);
+
+/* these run over the stored length with SSE2/AVX2 when the cpu has them, case changes only touch ascii letters. */
 HARBOL_EXPORT NO_NULL bool harbol_string_replace(struct HarbolString *str, char to_replace, char with);
 HARBOL_EXPORT NO_NULL size_t harbol_string_count(const struct HarbolString *str, char occurrence);
 
+
+/* searches go by the stored length so embedded nulls are fine, a missing 'needle' gives -1.
+ * 'find' looks for the first match at or after 'start', 'rfind' for the last match that ends at or before 'end'.
+ * 'find_all' writes up to 'out_len' starts of non-overlapping matches to 'out' and returns how many there are in total.
+ */
+HARBOL_EXPORT NO_NULL index_t harbol_string_find(const struct HarbolString *str, struct HarbolStrView needle, size_t start);
+HARBOL_EXPORT NO_NULL index_t harbol_string_rfind(const struct HarbolString *str, struct HarbolStrView needle, size_t end);
+HARBOL_EXPORT NEVER_NULL(1) size_t harbol_string_find_all(const struct HarbolString *str, struct HarbolStrView needle, size_t out[], size_t out_len);
+
 HARBOL_EXPORT NO_NULL bool harbol_string_upper(struct HarbolString *str);
 HARBOL_EXPORT NO_NULL bool harbol_string_lower(struct HarbolString *str);
 HARBOL_EXPORT NO_NULL bool harbol_string_reverse(struct HarbolString *str);
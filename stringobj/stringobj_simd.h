@@ -0,0 +1,466 @@
+#ifndef HARBOL_STRING_SIMD_INCLUDED
+#	define HARBOL_STRING_SIMD_INCLUDED
+
+/* bulk char & search kernels for the string object, not part of the public api.
+ * SSE2 is picked at compile time like the map's group probing,
+ * AVX2 gets compiled in with gcc/clang target attributes and is only used if the cpu has it.
+ * define 'HARBOL_STRING_NO_SIMD' to force the scalar loops.
+ */
+#include "stringobj.h"
+
+#ifndef HARBOL_STRING_NO_SIMD
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		include <emmintrin.h>
+#		define HARBOL_STRING_SSE2
+#	endif
+#	if defined(HARBOL_STRING_SSE2) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG)) && (defined(__x86_64__) || defined(__i386__))
+#		include <immintrin.h>
+#		define HARBOL_STRING_AVX2
+#		define HARBOL_STRING_TARGET_AVX2    __attribute__((target("avx2")))
+#	endif
+#endif
+
+#ifdef COMPILER_MSVC
+#	include <intrin.h>
+#endif
+
+/* needles longer than this skip the first & last byte filter for horspool since the filter's worst case is quadratic. */
+#ifndef HARBOL_STRING_FILTER_MAX
+#	define HARBOL_STRING_FILTER_MAX    32
+#endif
+
+
+/* case flipping only touches ascii letters, 'first' is either 'a' or 'A'. */
+static inline bool __harbol_string_in_case(const char c, const char first)
+{
+	return (uint8_t)(c - first) <= 25;
+}
+
+static inline size_t __harbol_string_count_scalar(const char buf[const], const size_t len, const char c)
+{
+	size_t counts = 0;
+	for( uindex_t i=0; i<len; i++ )
+		counts += buf[i]==c;
+	return counts;
+}
+
+static inline void __harbol_string_replace_scalar(char buf[const], const size_t len, const char from, const char to)
+{
+	for( uindex_t i=0; i<len; i++ )
+		if( buf[i]==from )
+			buf[i] = to;
+}
+
+static inline void __harbol_string_flip_case_scalar(char buf[const], const size_t len, const char first)
+{
+	for( uindex_t i=0; i<len; i++ )
+		if( __harbol_string_in_case(buf[i], first) )
+			buf[i] ^= 0x20;
+}
+
+/* reverses the chars between 'lo' and 'hi', the vector kernels hand their leftover middle to this. */
+static inline void __harbol_string_reverse_scalar(char buf[const], size_t lo, size_t hi)
+{
+	while( hi > lo + 1 ) {
+		const char c = buf[lo];
+		buf[lo++] = buf[--hi];
+		buf[hi] = c;
+	}
+}
+
+/* the search kernels take window starts in '[lo, hi]' and need '0 < nlen <= hay_len'. */
+static inline index_t __harbol_string_find_scalar(const char hay[const], const size_t lo, const size_t hi, const char needle[const], const size_t nlen)
+{
+	for( size_t i=lo; i<=hi; i++ )
+		if( hay[i]==needle[0] && hay[i + nlen - 1]==needle[nlen - 1] && !memcmp(&hay[i], needle, nlen) )
+			return (index_t)i;
+	return -1;
+}
+
+static inline index_t __harbol_string_rfind_scalar(const char hay[const], const size_t lo, const size_t hi, const char needle[const], const size_t nlen)
+{
+	for( size_t i=hi + 1; i-- > lo; )
+		if( hay[i]==needle[0] && hay[i + nlen - 1]==needle[nlen - 1] && !memcmp(&hay[i], needle, nlen) )
+			return (index_t)i;
+	return -1;
+}
+
+/* scalar builds still get libc's vectorized memchr to skip to each first byte. */
+static inline index_t __harbol_string_find_memchr(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	const char *const end = &hay[hay_len - nlen + 1];
+	for( const char *iter = hay; iter < end && (iter = memchr(iter, needle[0], (size_t)(end - iter))) != NULL; iter++ )
+		if( !memcmp(iter, needle, nlen) )
+			return (index_t)(iter - hay);
+	return -1;
+}
+
+static inline index_t __harbol_string_find_horspool(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	size_t shift[UINT8_MAX + 1];
+	for( uindex_t i=0; i<=UINT8_MAX; i++ )
+		shift[i] = nlen;
+	for( uindex_t i=0; i<nlen - 1; i++ )
+		shift[(uint8_t)needle[i]] = nlen - 1 - i;
+	
+	for( size_t i=0; i <= hay_len - nlen; i += shift[(uint8_t)hay[i + nlen - 1]] )
+		if( hay[i + nlen - 1]==needle[nlen - 1] && !memcmp(&hay[i], needle, nlen - 1) )
+			return (index_t)i;
+	return -1;
+}
+
+/* mirror image of the forward horspool, windows slide left and shift on their first char. */
+static inline index_t __harbol_string_rfind_horspool(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	size_t shift[UINT8_MAX + 1];
+	for( uindex_t i=0; i<=UINT8_MAX; i++ )
+		shift[i] = nlen;
+	for( uindex_t i=nlen - 1; i>0; i-- )
+		shift[(uint8_t)needle[i]] = i;
+	
+	for( size_t i=hay_len - nlen; ; i -= shift[(uint8_t)hay[i]] ) {
+		if( hay[i]==needle[0] && !memcmp(&hay[i + 1], &needle[1], nlen - 1) )
+			return (index_t)i;
+		else if( i < shift[(uint8_t)hay[i]] )
+			return -1;
+	}
+}
+
+
+#ifdef HARBOL_STRING_SSE2
+static inline size_t __harbol_string_lowest_bit(const uint32_t mask)
+{
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+	return (size_t)__builtin_ctz(mask);
+#elif defined(COMPILER_MSVC)
+	unsigned long i = 0;
+	_BitScanForward(&i, mask);
+	return i;
+#else
+	size_t i = 0;
+	while( !(mask & (1u << i)) )
+		i++;
+	return i;
+#endif
+}
+
+static inline size_t __harbol_string_highest_bit(const uint32_t mask)
+{
+#if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+	return 31 - (size_t)__builtin_clz(mask);
+#elif defined(COMPILER_MSVC)
+	unsigned long i = 0;
+	_BitScanReverse(&i, mask);
+	return i;
+#else
+	size_t i = 31;
+	while( !(mask & (1u << i)) )
+		i--;
+	return i;
+#endif
+}
+
+static inline size_t __harbol_string_count_sse2(const char buf[const], const size_t len, const char c)
+{
+	const __m128i needle = _mm_set1_epi8(c);
+	size_t counts = 0, i = 0;
+	while( len - i >= 16 ) {
+		/* byte lanes count up by subtracting the -1 matches, flushed before any of them can wrap. */
+		__m128i lanes = _mm_setzero_si128();
+		for( size_t n=0; n<255 && len - i >= 16; n++, i += 16 )
+			lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&buf[i]), needle));
+		const __m128i sums = _mm_sad_epu8(lanes, _mm_setzero_si128());
+		counts += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+	}
+	return counts + __harbol_string_count_scalar(&buf[i], len - i, c);
+}
+
+static inline void __harbol_string_replace_sse2(char buf[const], const size_t len, const char from, const char to)
+{
+	const __m128i match = _mm_set1_epi8(from), with = _mm_set1_epi8(to);
+	size_t i = 0;
+	for( ; len - i >= 16; i += 16 ) {
+		const __m128i chars = _mm_loadu_si128((const __m128i *)&buf[i]);
+		const __m128i eq = _mm_cmpeq_epi8(chars, match);
+		_mm_storeu_si128((__m128i *)&buf[i], _mm_or_si128(_mm_and_si128(eq, with), _mm_andnot_si128(eq, chars)));
+	}
+	__harbol_string_replace_scalar(&buf[i], len - i, from, to);
+}
+
+static inline void __harbol_string_flip_case_sse2(char buf[const], const size_t len, const char first)
+{
+	const __m128i base = _mm_set1_epi8(first), span = _mm_set1_epi8(25), bit = _mm_set1_epi8(0x20);
+	size_t i = 0;
+	for( ; len - i >= 16; i += 16 ) {
+		const __m128i chars = _mm_loadu_si128((const __m128i *)&buf[i]);
+		const __m128i offs = _mm_sub_epi8(chars, base);
+		const __m128i in_case = _mm_cmpeq_epi8(_mm_min_epu8(offs, span), offs);
+		_mm_storeu_si128((__m128i *)&buf[i], _mm_xor_si128(chars, _mm_and_si128(in_case, bit)));
+	}
+	__harbol_string_flip_case_scalar(&buf[i], len - i, first);
+}
+
+static inline __m128i __harbol_string_rev16(__m128i chars)
+{
+	/* no byte shuffle in plain SSE2: swap the bytes of each word then reverse the words. */
+	chars = _mm_or_si128(_mm_slli_epi16(chars, 8), _mm_srli_epi16(chars, 8));
+	chars = _mm_shufflelo_epi16(chars, _MM_SHUFFLE(0,1,2,3));
+	chars = _mm_shufflehi_epi16(chars, _MM_SHUFFLE(0,1,2,3));
+	return _mm_shuffle_epi32(chars, _MM_SHUFFLE(1,0,3,2));
+}
+
+static inline void __harbol_string_reverse_sse2(char buf[const], size_t lo, size_t hi)
+{
+	for( ; hi - lo >= 32; lo += 16, hi -= 16 ) {
+		const __m128i front = _mm_loadu_si128((const __m128i *)&buf[lo]);
+		const __m128i back = _mm_loadu_si128((const __m128i *)&buf[hi - 16]);
+		_mm_storeu_si128((__m128i *)&buf[lo], __harbol_string_rev16(back));
+		_mm_storeu_si128((__m128i *)&buf[hi - 16], __harbol_string_rev16(front));
+	}
+	__harbol_string_reverse_scalar(buf, lo, hi);
+}
+
+/* only windows whose first & last chars both match get fully compared. */
+static inline uint32_t __harbol_string_filter16(const char window[const], const size_t nlen, const __m128i first, const __m128i last)
+{
+	const __m128i a = _mm_loadu_si128((const __m128i *)window);
+	const __m128i b = _mm_loadu_si128((const __m128i *)&window[nlen - 1]);
+	return (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+}
+
+static inline index_t __harbol_string_find_sse2(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	const __m128i first = _mm_set1_epi8(needle[0]), last = _mm_set1_epi8(needle[nlen - 1]);
+	const size_t end = hay_len - nlen;
+	size_t i = 0;
+	for( ; i + 15 <= end; i += 16 ) {
+		for( uint32_t mask = __harbol_string_filter16(&hay[i], nlen, first, last); mask != 0; mask &= mask - 1 ) {
+			const size_t at = i + __harbol_string_lowest_bit(mask);
+			if( nlen <= 2 || !memcmp(&hay[at + 1], &needle[1], nlen - 2) )
+				return (index_t)at;
+		}
+	}
+	return __harbol_string_find_scalar(hay, i, end, needle, nlen);
+}
+
+static inline index_t __harbol_string_rfind_sse2(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	const __m128i first = _mm_set1_epi8(needle[0]), last = _mm_set1_epi8(needle[nlen - 1]);
+	size_t top = hay_len - nlen + 1; // windows left to check are '[0, top)'.
+	for( ; top >= 16; top -= 16 ) {
+		const size_t i = top - 16;
+		for( uint32_t mask = __harbol_string_filter16(&hay[i], nlen, first, last); mask != 0; ) {
+			const size_t bit = __harbol_string_highest_bit(mask);
+			const size_t at = i + bit;
+			if( nlen <= 2 || !memcmp(&hay[at + 1], &needle[1], nlen - 2) )
+				return (index_t)at;
+			mask ^= 1u << bit;
+		}
+	}
+	return( top==0 ) ? -1 : __harbol_string_rfind_scalar(hay, 0, top - 1, needle, nlen);
+}
+#endif
+
+
+#ifdef HARBOL_STRING_AVX2
+static inline bool __harbol_string_has_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+static HARBOL_STRING_TARGET_AVX2 size_t __harbol_string_count_avx2(const char buf[const], const size_t len, const char c)
+{
+	const __m256i needle = _mm256_set1_epi8(c);
+	size_t counts = 0, i = 0;
+	while( len - i >= 32 ) {
+		__m256i lanes = _mm256_setzero_si256();
+		for( size_t n=0; n<255 && len - i >= 32; n++, i += 32 )
+			lanes = _mm256_sub_epi8(lanes, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)&buf[i]), needle));
+		const __m256i sums = _mm256_sad_epu8(lanes, _mm256_setzero_si256());
+		const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+		counts += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(half, 8));
+	}
+	return counts + __harbol_string_count_sse2(&buf[i], len - i, c);
+}
+
+static HARBOL_STRING_TARGET_AVX2 void __harbol_string_replace_avx2(char buf[const], const size_t len, const char from, const char to)
+{
+	const __m256i match = _mm256_set1_epi8(from), with = _mm256_set1_epi8(to);
+	size_t i = 0;
+	for( ; len - i >= 32; i += 32 ) {
+		const __m256i chars = _mm256_loadu_si256((const __m256i *)&buf[i]);
+		_mm256_storeu_si256((__m256i *)&buf[i], _mm256_blendv_epi8(chars, with, _mm256_cmpeq_epi8(chars, match)));
+	}
+	__harbol_string_replace_sse2(&buf[i], len - i, from, to);
+}
+
+static HARBOL_STRING_TARGET_AVX2 void __harbol_string_flip_case_avx2(char buf[const], const size_t len, const char first)
+{
+	const __m256i base = _mm256_set1_epi8(first), span = _mm256_set1_epi8(25), bit = _mm256_set1_epi8(0x20);
+	size_t i = 0;
+	for( ; len - i >= 32; i += 32 ) {
+		const __m256i chars = _mm256_loadu_si256((const __m256i *)&buf[i]);
+		const __m256i offs = _mm256_sub_epi8(chars, base);
+		const __m256i in_case = _mm256_cmpeq_epi8(_mm256_min_epu8(offs, span), offs);
+		_mm256_storeu_si256((__m256i *)&buf[i], _mm256_xor_si256(chars, _mm256_and_si256(in_case, bit)));
+	}
+	__harbol_string_flip_case_sse2(&buf[i], len - i, first);
+}
+
+static HARBOL_STRING_TARGET_AVX2 void __harbol_string_reverse_avx2(char buf[const], size_t lo, size_t hi)
+{
+	/* pshufb only reverses within each 128-bit lane so the lanes get swapped afterwards. */
+	const __m256i rev = _mm256_setr_epi8(
+		15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0,
+		15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0
+	);
+	for( ; hi - lo >= 64; lo += 32, hi -= 32 ) {
+		const __m256i front = _mm256_loadu_si256((const __m256i *)&buf[lo]);
+		const __m256i back = _mm256_loadu_si256((const __m256i *)&buf[hi - 32]);
+		_mm256_storeu_si256((__m256i *)&buf[lo], _mm256_permute4x64_epi64(_mm256_shuffle_epi8(back, rev), 0x4E));
+		_mm256_storeu_si256((__m256i *)&buf[hi - 32], _mm256_permute4x64_epi64(_mm256_shuffle_epi8(front, rev), 0x4E));
+	}
+	__harbol_string_reverse_sse2(buf, lo, hi);
+}
+
+static HARBOL_STRING_TARGET_AVX2 uint32_t __harbol_string_filter32(const char window[const], const size_t nlen, const __m256i first, const __m256i last)
+{
+	const __m256i a = _mm256_loadu_si256((const __m256i *)window);
+	const __m256i b = _mm256_loadu_si256((const __m256i *)&window[nlen - 1]);
+	return (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+}
+
+static HARBOL_STRING_TARGET_AVX2 index_t __harbol_string_find_avx2(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	const __m256i first = _mm256_set1_epi8(needle[0]), last = _mm256_set1_epi8(needle[nlen - 1]);
+	const size_t end = hay_len - nlen;
+	size_t i = 0;
+	for( ; i + 31 <= end; i += 32 ) {
+		for( uint32_t mask = __harbol_string_filter32(&hay[i], nlen, first, last); mask != 0; mask &= mask - 1 ) {
+			const size_t at = i + __harbol_string_lowest_bit(mask);
+			if( nlen <= 2 || !memcmp(&hay[at + 1], &needle[1], nlen - 2) )
+				return (index_t)at;
+		}
+	}
+	if( i > end )
+		return -1;
+	
+	const index_t found = __harbol_string_find_sse2(&hay[i], hay_len - i, needle, nlen);
+	return( found<0 ) ? -1 : found + (index_t)i;
+}
+
+static HARBOL_STRING_TARGET_AVX2 index_t __harbol_string_rfind_avx2(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	const __m256i first = _mm256_set1_epi8(needle[0]), last = _mm256_set1_epi8(needle[nlen - 1]);
+	size_t top = hay_len - nlen + 1;
+	for( ; top >= 32; top -= 32 ) {
+		const size_t i = top - 32;
+		for( uint32_t mask = __harbol_string_filter32(&hay[i], nlen, first, last); mask != 0; ) {
+			const size_t bit = __harbol_string_highest_bit(mask);
+			const size_t at = i + bit;
+			if( nlen <= 2 || !memcmp(&hay[at + 1], &needle[1], nlen - 2) )
+				return (index_t)at;
+			mask ^= 1u << bit;
+		}
+	}
+	/* the windows left all start below 'top' so cut the haystack off right after the last of them. */
+	return( top==0 ) ? -1 : __harbol_string_rfind_sse2(hay, top - 1 + nlen, needle, nlen);
+}
+#endif
+
+
+/* dispatchers, the cpu check is a cached flag so it's cheap enough to do per call. */
+static inline size_t __harbol_string_count_kernel(const char buf[const], const size_t len, const char c)
+{
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() )
+		return __harbol_string_count_avx2(buf, len, c);
+#endif
+#ifdef HARBOL_STRING_SSE2
+	return __harbol_string_count_sse2(buf, len, c);
+#else
+	return __harbol_string_count_scalar(buf, len, c);
+#endif
+}
+
+static inline void __harbol_string_replace_kernel(char buf[const], const size_t len, const char from, const char to)
+{
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() ) {
+		__harbol_string_replace_avx2(buf, len, from, to);
+		return;
+	}
+#endif
+#ifdef HARBOL_STRING_SSE2
+	__harbol_string_replace_sse2(buf, len, from, to);
+#else
+	__harbol_string_replace_scalar(buf, len, from, to);
+#endif
+}
+
+static inline void __harbol_string_flip_case_kernel(char buf[const], const size_t len, const char first)
+{
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() ) {
+		__harbol_string_flip_case_avx2(buf, len, first);
+		return;
+	}
+#endif
+#ifdef HARBOL_STRING_SSE2
+	__harbol_string_flip_case_sse2(buf, len, first);
+#else
+	__harbol_string_flip_case_scalar(buf, len, first);
+#endif
+}
+
+static inline void __harbol_string_reverse_kernel(char buf[const], const size_t len)
+{
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() ) {
+		__harbol_string_reverse_avx2(buf, 0, len);
+		return;
+	}
+#endif
+#ifdef HARBOL_STRING_SSE2
+	__harbol_string_reverse_sse2(buf, 0, len);
+#else
+	__harbol_string_reverse_scalar(buf, 0, len);
+#endif
+}
+
+/* 'nlen' has to be in '(0, hay_len]', the string object handles empty needles & short haystacks itself. */
+static inline index_t __harbol_string_find_kernel(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	if( nlen==1 ) {
+		const char *const found = memchr(hay, needle[0], hay_len);
+		return( found==NULL ) ? -1 : (index_t)(found - hay);
+	} else if( nlen > HARBOL_STRING_FILTER_MAX ) {
+		return __harbol_string_find_horspool(hay, hay_len, needle, nlen);
+	}
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() )
+		return __harbol_string_find_avx2(hay, hay_len, needle, nlen);
+#endif
+#ifdef HARBOL_STRING_SSE2
+	return __harbol_string_find_sse2(hay, hay_len, needle, nlen);
+#else
+	return __harbol_string_find_memchr(hay, hay_len, needle, nlen);
+#endif
+}
+
+static inline index_t __harbol_string_rfind_kernel(const char hay[const], const size_t hay_len, const char needle[const], const size_t nlen)
+{
+	if( nlen > HARBOL_STRING_FILTER_MAX )
+		return __harbol_string_rfind_horspool(hay, hay_len, needle, nlen);
+#ifdef HARBOL_STRING_AVX2
+	if( __harbol_string_has_avx2() )
+		return __harbol_string_rfind_avx2(hay, hay_len, needle, nlen);
+#endif
+#ifdef HARBOL_STRING_SSE2
+	return __harbol_string_rfind_sse2(hay, hay_len, needle, nlen);
+#else
+	return __harbol_string_rfind_scalar(hay, 0, hay_len - nlen, needle, nlen);
+#endif
+}
+
+#endif /* HARBOL_STRING_SIMD_INCLUDED */
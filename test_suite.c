@@ -1,6 +1,11 @@
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime in the threaded benchmarks. */
 #include <assert.h>
+#include <ctype.h>
 #include <stdalign.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/uio.h>
 #include "harbol.h"
 
 void test_harbol_string(void);
@@ -9,17 +14,22 @@ void test_harbol_unilist(void);
 void test_harbol_bilist(void);
 void test_harbol_tuple(void);
 void test_harbol_bytebuffer(void);
+void test_harbol_hash(void);
 void test_harbol_map(void);
+void test_harbol_intmap(void);
+void test_harbol_concmap(void);
 void test_harbol_mempool(void);
 void test_harbol_objpool(void);
 void test_harbol_cache(void);
 void test_harbol_graph(void);
 void test_harbol_tree(void);
 void test_harbol_linkmap(void);
+void test_harbol_frozenmap(void);
 void test_harbol_cfg(void);
 void test_harbol_plugins(void);
 void test_harbol_veque(void);
 void test_harbol_lex(void);
+void test_harbol_fileview(void);
 
 FILE *g_harbol_debug_stream = NULL;
 
@@ -61,10 +71,14 @@ int main()
 	test_harbol_bilist();
 	test_harbol_tuple();
 	test_harbol_bytebuffer();
+	test_harbol_hash();
 	test_harbol_map();
+	test_harbol_intmap();
+	test_harbol_concmap();
 	test_harbol_graph();
 	test_harbol_tree();
 	test_harbol_linkmap();
+	test_harbol_frozenmap();
 	test_harbol_cfg();
 	test_harbol_plugins();
 	
@@ -74,6 +88,7 @@ int main()
 	test_harbol_veque();
 	
 	test_harbol_lex();
+	test_harbol_fileview();
 	
 	fclose(g_harbol_debug_stream), g_harbol_debug_stream=NULL;
 #ifdef HARBOL_USE_MEMPOOL
@@ -95,6 +110,46 @@ static void __print_mempool_nodes(const struct HarbolMemPool *const mempool)
 	fprintf(g_harbol_debug_stream, "mempool memory remaining :: %zu | freenodes: %zu.\n", harbol_mempool_mem_remaining(mempool), mempool->freelist.len);
 }
 
+/* the per-char loops the string kernels replaced, kept to check & benchmark the SIMD versions against. */
+static void ref_string_replace(char str[], const char to_replace, const char with)
+{
+	for( char *i=str; *i; i++ )
+		if( *i==to_replace )
+			*i = with;
+}
+
+static size_t ref_string_count(const char str[], const char occurrence)
+{
+	size_t counts = 0;
+	for( const char *i=str; *i; i++ )
+		if( *i==occurrence )
+			++counts;
+	return counts;
+}
+
+static void ref_string_upper(char str[])
+{
+	for( char *i=str; *i; i++ )
+		if( islower(*i) )
+			*i=toupper(*i);
+}
+
+static void ref_string_lower(char str[])
+{
+	for( char *i=str; *i; i++ )
+		if( isupper(*i) )
+			*i=tolower(*i);
+}
+
+static void ref_string_reverse(char str[], const size_t full_len)
+{
+	for( size_t i=0, n=full_len-1; i<full_len / 2; i++, n-- ) {
+		const char c = str[i];
+		str[i] = str[n];
+		str[n] = c;
+	}
+}
+
 void test_harbol_string(void)
 {
 	if( !g_harbol_debug_stream )
@@ -105,13 +160,13 @@ void test_harbol_string(void)
 	fputs("\n", g_harbol_debug_stream);
 	struct HarbolString *p = harbol_string_new("test ptr with cstr!");
 	assert( p );
-	fputs(p->cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\np's string len '%zu' | strlen val '%zu'\n", p->len, strlen(p->cstr));
+	fputs(harbol_string_cstr(p), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\np's string len '%zu' | strlen val '%zu'\n", harbol_string_len(p), strlen(harbol_string_cstr(p)));
 	fputs("\n", g_harbol_debug_stream);
 	
 	struct HarbolString i = harbol_string_create("test stk with cstr!");
-	fputs(i.cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", i.len, strlen(i.cstr));
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", harbol_string_len(&i), strlen(harbol_string_cstr(&i)));
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test appending individual chars.
@@ -120,23 +175,23 @@ void test_harbol_string(void)
 	// correct output: test ptr with cstr!6
 	harbol_string_add_char(p, ' ');
 	harbol_string_add_char(p, '6');
-	fputs(p->cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(p), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	harbol_string_add_char(&i, ' ');
 	harbol_string_add_char(&i, '6');
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test appending strings.
 	fputs("string :: test appending C strings.", g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	harbol_string_add_cstr(p, " \'new string!\'");
-	fputs(p->cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(p), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	harbol_string_add_cstr(&i, " \'new string!\'");
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test appending string objects.
@@ -147,20 +202,20 @@ void test_harbol_string(void)
 	harbol_string_add_str(&i, p);
 	
 	// correct output: AB
-	fputs(p->cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(p), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	// correct output: BAB
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test copying string objects.
 	fputs("\nstring :: test copying string objects.\n", g_harbol_debug_stream);
 	harbol_string_copy_cstr(p, "copied from ptr!");
 	harbol_string_add_str(&i, p);
-	fputs(p->cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(p), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test string formatting.
@@ -168,24 +223,24 @@ void test_harbol_string(void)
 	harbol_string_clear(&i);
 	//harbol_string_reserve(&i, 100);
 	harbol_string_format(&i, "%i + %f + %i", 900, 4242.2, 10);
-	fputs(i.cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", i.len, strlen(i.cstr));
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", harbol_string_len(&i), strlen(harbol_string_cstr(&i)));
 	fputs("\n", g_harbol_debug_stream);
 	harbol_string_format(&i, "%i + %f", 900, 4242.2);
-	fputs(i.cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", i.len, strlen(i.cstr));
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", harbol_string_len(&i), strlen(harbol_string_cstr(&i)));
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test string concatenation formatting.
 	fputs("\nstring :: test string concatenation formatting.\n", g_harbol_debug_stream);
 	harbol_string_clear(&i);
 	harbol_string_format(&i, "%i + %f + %i + ", 900, 4242.2, 10);
-	fputs(i.cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", i.len, strlen(i.cstr));
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", harbol_string_len(&i), strlen(harbol_string_cstr(&i)));
 	
 	harbol_string_add_format(&i, "%i + %f + %i", 900, 4242.2, 10);
-	fputs(i.cstr, g_harbol_debug_stream);
-	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", i.len, strlen(i.cstr));
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
+	fprintf(g_harbol_debug_stream, "\ni's string len '%zu' | strlen val '%zu'\n", harbol_string_len(&i), strlen(harbol_string_cstr(&i)));
 	fputs("\n", g_harbol_debug_stream);
 	
 	// test reversing string.
@@ -194,29 +249,310 @@ void test_harbol_string(void)
 	harbol_string_clear(p);
 	i = harbol_string_create("test");
 	harbol_string_reverse(&i);
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	harbol_string_clear(&i);
 	i = harbol_string_create("abcd");
 	harbol_string_reverse(&i);
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
 	harbol_string_clear(&i);
 	i = harbol_string_create("hello world!");
 	harbol_string_reverse(&i);
-	fputs(i.cstr, g_harbol_debug_stream);
+	fputs(harbol_string_cstr(&i), g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	
+	// test reserving capacity.
+	fputs("\nstring :: test reserving capacity.\n", g_harbol_debug_stream);
+	harbol_string_clear(&i);
+	const bool reserved_ok = harbol_string_reserve(&i, 100);
+	assert( reserved_ok && harbol_string_cap(&i)==100 && harbol_string_len(&i)==0 && harbol_string_cstr(&i)[0]==0 );
+	{
+		const char *const reserved = harbol_string_cstr(&i);
+		for( uindex_t n=0; n<100; n++ )
+			harbol_string_add_char(&i, 'a' + (n % 26));
+		fprintf(g_harbol_debug_stream, "i's len: '%zu' | cap: '%zu' | buffer moved? '%s'\n", harbol_string_len(&i), harbol_string_cap(&i), harbol_string_cstr(&i)==reserved ? "no" : "yes");
+		assert( harbol_string_len(&i)==100 && harbol_string_cstr(&i)==reserved && harbol_string_cstr(&i)[100]==0 );
+	}
+	harbol_string_copy_cstr(&i, "shrunk");
+	assert( harbol_string_len(&i)==6 && harbol_string_cap(&i)==100 && !strcmp(harbol_string_cstr(&i), "shrunk") );
+	
+	// test appending to itself & benchmarking appends.
+	fputs("\nstring :: test & benchmark appending.\n", g_harbol_debug_stream);
+	harbol_string_add_str(&i, &i);
+	assert( harbol_string_len(&i)==12 && !strcmp(harbol_string_cstr(&i), "shrunkshrunk") );
+	harbol_string_clear(&i);
+	{
+		const size_t chars = 1 << 20;
+		clock_t start = clock();
+		for( size_t n=0; n<chars; n++ )
+			harbol_string_add_char(&i, 'a' + (n % 26));
+		clock_t end = clock();
+		fprintf(g_harbol_debug_stream, "building a %zu char string char-by-char took: %f | cap: '%zu'\n", chars, (end-start)/(double)CLOCKS_PER_SEC, harbol_string_cap(&i));
+		assert( harbol_string_len(&i)==chars && strlen(harbol_string_cstr(&i))==chars && harbol_string_cstr(&i)[chars-1]=='a' + ((chars-1) % 26) );
+		harbol_string_clear(&i);
+		
+		start = clock();
+		for( size_t n=0; n<chars/8; n++ )
+			harbol_string_add_cstr(&i, "8 chars!");
+		end = clock();
+		fprintf(g_harbol_debug_stream, "building a %zu char string from cstrs took: %f\n", chars, (end-start)/(double)CLOCKS_PER_SEC);
+		assert( harbol_string_len(&i)==chars );
+		harbol_string_clear(&i);
+	}
+	
+	// test string views.
+	fputs("\nstring :: test string views.\n", g_harbol_debug_stream);
+	{
+		const char src[] = "key=value";
+		const struct HarbolStrView key = { src, 3 }, value = { &src[4], 5 };
+		struct HarbolString s = EMPTY_HARBOL_STRING;
+		harbol_string_copy_view(&s, key);
+		assert( !harbol_string_cmpcstr(&s, "key") && !harbol_string_cmpview(&s, key) && harbol_string_cmpview(&s, value) < 0 );
+		harbol_string_add_view(&s, (struct HarbolStrView){ &src[3], 6 });
+		assert( !strcmp(harbol_string_cstr(&s), src) && !harbol_strview_cmp(harbol_string_view(&s), harbol_strview(src)) );
+		assert( harbol_strview_cmp(key, (struct HarbolStrView){ src, 2 }) > 0 && harbol_strview_cmp((struct HarbolStrView)EMPTY_HARBOL_STRVIEW, key) < 0 );
+		harbol_string_clear(&s);
+	}
+	
+	// test & benchmark the bulk char kernels against the plain loops.
+	fputs("\nstring :: test & benchmark bulk char operations.\n", g_harbol_debug_stream);
+	{
+		const char line[] = "[2024-01-01 12:00:00] INFO  GET /api/v1/Users?id=42 -> 200 OK (3ms)\n";
+		// every length up to a few vectors, so every tail path gets hit.
+		for( size_t len=0; len<200; len++ ) {
+			char ref[256] = {0};
+			for( size_t n=0; n<len; n++ )
+				ref[n] = line[(n * 7) % (sizeof line - 1)];
+			struct HarbolString s = EMPTY_HARBOL_STRING;
+			harbol_string_copy_cstr(&s, ref);
+			assert( harbol_string_count(&s, ' ')==ref_string_count(ref, ' ') );
+			harbol_string_replace(&s, ' ', '_'), ref_string_replace(ref, ' ', '_');
+			assert( !strcmp(harbol_string_cstr(&s), ref) );
+			harbol_string_upper(&s), ref_string_upper(ref);
+			assert( !strcmp(harbol_string_cstr(&s), ref) );
+			harbol_string_lower(&s), ref_string_lower(ref);
+			assert( !strcmp(harbol_string_cstr(&s), ref) );
+			if( len > 0 )
+				ref_string_reverse(ref, len);
+			harbol_string_reverse(&s);
+			assert( !strcmp(harbol_string_cstr(&s), ref) );
+			harbol_string_clear(&s);
+		}
+		
+		struct HarbolString payload = EMPTY_HARBOL_STRING;
+		while( harbol_string_len(&payload) < (16u << 20) )
+			harbol_string_add_cstr(&payload, line);
+		const size_t bytes = harbol_string_len(&payload);
+		char *const ref = harbol_alloc(bytes + 1, sizeof *ref);
+		memcpy(ref, harbol_string_cstr(&payload), bytes + 1);
+		
+		enum { BulkCount, BulkReplace, BulkUpper, BulkLower, BulkReverse, BulkOps };
+		static const char *const op_names[BulkOps] = { "count", "replace", "upper", "lower", "reverse" };
+		const int passes = 4;
+		for( int op=0; op<BulkOps; op++ ) {
+			size_t counted = 0, ref_counted = 0;
+			clock_t start = clock();
+			for( int n=0; n<passes; n++ ) {
+				switch( op ) {
+					case BulkCount:   ref_counted += ref_string_count(ref, ' '); break;
+					case BulkReplace: ref_string_replace(ref, n & 1 ? '_' : ' ', n & 1 ? ' ' : '_'); break;
+					case BulkUpper:   ref_string_upper(ref); break;
+					case BulkLower:   ref_string_lower(ref); break;
+					case BulkReverse: ref_string_reverse(ref, bytes); break;
+				}
+			}
+			const double ref_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+			
+			start = clock();
+			for( int n=0; n<passes; n++ ) {
+				switch( op ) {
+					case BulkCount:   counted += harbol_string_count(&payload, ' '); break;
+					case BulkReplace: harbol_string_replace(&payload, n & 1 ? '_' : ' ', n & 1 ? ' ' : '_'); break;
+					case BulkUpper:   harbol_string_upper(&payload); break;
+					case BulkLower:   harbol_string_lower(&payload); break;
+					case BulkReverse: harbol_string_reverse(&payload); break;
+				}
+			}
+			const double simd_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+			assert( counted==ref_counted && !memcmp(harbol_string_cstr(&payload), ref, bytes) );
+			
+			const double gbs = (double)bytes * passes / 1e9;
+			fprintf(g_harbol_debug_stream, "%-8s %zu bytes :: plain loop: %.2f GB/s | kernel: %.2f GB/s\n", op_names[op], bytes, gbs / (ref_time > 0 ? ref_time : 1e-9), gbs / (simd_time > 0 ? simd_time : 1e-9));
+		}
+		harbol_free(ref);
+		harbol_string_clear(&payload);
+	}
+	
+	// test substring searching against a naive search, small alphabets give lots of partial matches.
+	fputs("\nstring :: test & benchmark substring searching.\n", g_harbol_debug_stream);
+	{
+		uint32_t rng = 12345;
+		for( size_t round=0; round<400; round++ ) {
+			char hay[300] = {0}, needle[80] = {0};
+			const size_t hay_len = (round * 37) % sizeof hay;
+			const size_t nlen = 1 + (round % 70);
+			for( size_t n=0; n<hay_len; n++ )
+				hay[n] = 'a' + ((rng = rng * 1103515245u + 12345u) >> 16) % 3;
+			for( size_t n=0; n<nlen; n++ )
+				needle[n] = 'a' + ((rng = rng * 1103515245u + 12345u) >> 16) % ((round & 1) ? 3 : 1);
+			// plant the needle so most rounds actually find something.
+			if( nlen <= hay_len && (round & 2) )
+				memcpy(&hay[(round * 13) % (hay_len - nlen + 1)], needle, nlen);
+			
+			struct HarbolString s = EMPTY_HARBOL_STRING;
+			harbol_string_copy_view(&s, (struct HarbolStrView){ hay, hay_len });
+			const struct HarbolStrView n = { needle, nlen };
+			index_t first = -1, second = -1, last = -1, before_last = -1;
+			for( size_t i=0; i + nlen <= hay_len; i++ ) {
+				if( !memcmp(&hay[i], needle, nlen) ) {
+					if( first<0 )
+						first = (index_t)i;
+					else if( second<0 )
+						second = (index_t)i;
+					before_last = last;
+					last = (index_t)i;
+				}
+			}
+			assert( harbol_string_find(&s, n, 0)==first && harbol_string_rfind(&s, n, SIZE_MAX)==last );
+			if( first >= 0 )
+				assert( harbol_string_find(&s, n, (size_t)first + 1)==second && harbol_string_rfind(&s, n, (size_t)last + nlen - 1)==before_last );
+			
+			size_t all[300], expected = 0;
+			const size_t total = harbol_string_find_all(&s, n, all, sizeof all / sizeof all[0]);
+			for( size_t i=0; i + nlen <= hay_len; ) {
+				if( !memcmp(&hay[i], needle, nlen) ) {
+					assert( all[expected++]==i );
+					i += nlen;
+				}
+				else i++;
+			}
+			assert( total==expected );
+			harbol_string_clear(&s);
+		}
+		
+		struct HarbolString s = harbol_string_create("needle in a haystack");
+		assert( harbol_string_find(&s, harbol_strview(""), 3)==3 && harbol_string_find(&s, harbol_strview("a"), 100)==-1 );
+		assert( harbol_string_rfind(&s, harbol_strview("a"), SIZE_MAX)==17 && harbol_string_rfind(&s, harbol_strview("a"), 17)==13 );
+		assert( harbol_string_find_all(&s, harbol_strview("a"), NULL, 0)==3 );
+		harbol_string_clear(&s);
+		
+		// benchmark against strstr with a short needle for the byte filter & a long one for horspool, the match is at the very end.
+		struct HarbolString text = EMPTY_HARBOL_STRING;
+		while( harbol_string_len(&text) < (8u << 20) )
+			harbol_string_add_cstr(&text, "the quick brown fox jumps over the lazy dog. ");
+		harbol_string_add_cstr(&text, "the quick brown fox jumps over the lazy cat.");
+		static const char *const needles[] = { "lazy cat", "the quick brown fox jumps over the lazy cat." };
+		for( size_t n=0; n<sizeof needles / sizeof needles[0]; n++ ) {
+			clock_t start = clock();
+			const char *const found = strstr(harbol_string_cstr(&text), needles[n]);
+			const double strstr_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+			start = clock();
+			const index_t at = harbol_string_find(&text, harbol_strview(needles[n]), 0);
+			const double find_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+			start = clock();
+			const index_t rat = harbol_string_rfind(&text, harbol_strview(needles[n]), SIZE_MAX);
+			const double rfind_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+			assert( found != NULL && at==(index_t)(found - harbol_string_cstr(&text)) && rat==at );
+			fprintf(g_harbol_debug_stream, "finding a %zu char needle in %zu chars :: strstr: %f secs | find: %f secs | rfind: %f secs\n", strlen(needles[n]), harbol_string_len(&text), strstr_time, find_time, rfind_time);
+		}
+		harbol_string_clear(&text);
+	}
+	
+	// test small string optimization.
+	fputs("\nstring :: test small string optimization.\n", g_harbol_debug_stream);
+	{
+		char sso_max[HARBOL_STRING_SSO_CAP + 1] = {0};
+		memset(sso_max, 'x', HARBOL_STRING_SSO_CAP);
+		struct HarbolString s = harbol_string_create(sso_max);
+		fprintf(g_harbol_debug_stream, "sizeof(struct HarbolString): '%zu' | inline cap: '%zu' | on heap? '%s'\n", sizeof s, (size_t)HARBOL_STRING_SSO_CAP, harbol_string_is_heap(&s) ? "yes" : "no");
+		assert( !harbol_string_is_heap(&s) && harbol_string_len(&s)==HARBOL_STRING_SSO_CAP && !strcmp(harbol_string_cstr(&s), sso_max) );
+		assert( (const char *)harbol_string_cstr(&s) >= (const char *)&s && (const char *)harbol_string_cstr(&s) < (const char *)(&s + 1) );
+		
+		// one more char spills to the heap and keeps the contents.
+		harbol_string_add_char(&s, 'y');
+		assert( harbol_string_is_heap(&s) && harbol_string_len(&s)==HARBOL_STRING_SSO_CAP + 1 && harbol_string_cstr(&s)[HARBOL_STRING_SSO_CAP]=='y' && !strncmp(harbol_string_cstr(&s), sso_max, HARBOL_STRING_SSO_CAP) );
+		harbol_string_clear(&s);
+		assert( !harbol_string_is_heap(&s) && harbol_string_len(&s)==0 && harbol_string_cstr(&s)[0]==0 );
+		
+		// the stored capacity survives the tag byte.
+		const bool big_reserved = harbol_string_reserve(&s, 0x123456);
+		assert( big_reserved && harbol_string_cap(&s)==0x123456 && harbol_string_is_heap(&s) );
+		harbol_string_clear(&s);
+		
+		// borrowed strings copy their chars out on the first write.
+		const char borrowed[] = "borrowed";
+		s = harbol_string_borrow(borrowed, sizeof borrowed - 1);
+		assert( harbol_string_cstr(&s)==borrowed && harbol_string_cap(&s)==0 && !harbol_string_cmpcstr(&s, "borrowed") );
+		harbol_string_upper(&s);
+		assert( harbol_string_cstr(&s) != borrowed && !strcmp(harbol_string_cstr(&s), "BORROWED") && !strcmp(borrowed, "borrowed") );
+		harbol_string_clear(&s);
+	}
+	
+	// test the chunked builder against building the same text in one string.
+	fputs("\nstring :: test chunked string builder.\n", g_harbol_debug_stream);
+	{
+		struct HarbolStrBuilder builder = harbol_strbuilder_create();
+		struct HarbolString ref = harbol_string_create("");
+		
+		// empty output on a builder with no chunks yet.
+		const int32_t empty_res = harbol_strbuilder_add_format(&builder, "%s", "");
+		assert( empty_res==0 && builder.tail==NULL && harbol_strbuilder_len(&builder)==0 );
+		for( size_t n=0; n<2000; n++ ) {
+			harbol_strbuilder_add_format(&builder, "line %zu: ", n);
+			harbol_string_add_format(&ref, "line %zu: ", n);
+			harbol_strbuilder_add_cstr(&builder, "text");
+			harbol_string_add_cstr(&ref, "text");
+			harbol_strbuilder_add_char(&builder, '\n');
+			harbol_string_add_char(&ref, '\n');
+		}
+		
+		// appends bigger than a whole chunk, by view and by format.
+		char big[HARBOL_STRBUILDER_CHUNK * 2 + 7];
+		memset(big, 'z', sizeof big);
+		harbol_strbuilder_add_view(&builder, (struct HarbolStrView){ big, sizeof big });
+		harbol_string_add_view(&ref, (struct HarbolStrView){ big, sizeof big });
+		harbol_strbuilder_add_format(&builder, "%*d|", HARBOL_STRBUILDER_CHUNK + 3, 42);
+		harbol_string_add_format(&ref, "%*d|", HARBOL_STRBUILDER_CHUNK + 3, 42);
+		harbol_strbuilder_add_str(&builder, &i);
+		harbol_string_add_str(&ref, &i);
+		
+		size_t chunks = 0;
+		for( const struct HarbolStrChunk *chunk = builder.head; chunk != NULL; chunk = chunk->next )
+			chunks++;
+		fprintf(g_harbol_debug_stream, "builder len: '%zu' | chunks: '%zu'\n", harbol_strbuilder_len(&builder), chunks);
+		assert( harbol_strbuilder_len(&builder)==harbol_string_len(&ref) && chunks > 1 );
+		
+		struct HarbolString flat = harbol_strbuilder_to_str(&builder);
+		assert( !harbol_string_cmpstr(&flat, &ref) );
+		harbol_string_clear(&flat);
+		
+		FILE *tmp = tmpfile();
+		if( tmp != NULL ) {
+			const bool written = harbol_strbuilder_write_file(&builder, tmp);
+			assert( written );
+			rewind(tmp);
+			struct HarbolString from_file = harbol_string_create("");
+			harbol_string_read_file(&from_file, tmp);
+			assert( !harbol_string_cmpstr(&from_file, &ref) );
+			harbol_string_clear(&from_file);
+			fclose(tmp);
+		}
+		harbol_strbuilder_clear(&builder);
+		assert( builder.head==NULL && harbol_strbuilder_len(&builder)==0 );
+		harbol_string_clear(&ref);
+	}
+	
 	// free data
 	fputs("string :: test destruction.", g_harbol_debug_stream);
 	fputs("\n", g_harbol_debug_stream);
 	harbol_string_clear(&i);
-	fprintf(g_harbol_debug_stream, "i's string is null? '%s'\n", i.cstr ? "no" : "yes");
+	fprintf(g_harbol_debug_stream, "i's string is empty? '%s'\n", harbol_string_is_empty(&i) ? "yes" : "no");
 	
 	harbol_string_clear(p);
-	fprintf(g_harbol_debug_stream, "p's string is null? '%s'\n", p->cstr ? "no" : "yes");
+	fprintf(g_harbol_debug_stream, "p's string is empty? '%s'\n", harbol_string_is_empty(p) ? "yes" : "no");
 	harbol_string_free(&p);
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
@@ -346,6 +682,38 @@ void test_harbol_vector(void)
 		fprintf(g_harbol_debug_stream, "post-reversing ptr[%zu] == %" PRIi64 "\n", i, ((union Value *)harbol_vector_get(p, i))->int64);
 	
 	
+	// test reserving & realloc growth.
+	fputs("\nvector :: test reserving & growth.\n", g_harbol_debug_stream);
+	{
+		struct HarbolVector r = harbol_vector_create(sizeof(union Value), VEC_DEFAULT_SIZE);
+		const bool reserved_ok = harbol_vector_reserve(&r, 1000);
+		assert( reserved_ok && r.len==1000 );
+		const uint8_t *const reserved = r.table;
+		/* a byte count that would wrap gets refused instead of reallocing a tiny block. */
+		const bool wrapped_ok = harbol_vector_reserve(&r, SIZE_MAX / sizeof(union Value) + 2);
+		assert( !wrapped_ok && r.table==reserved && r.len==1000 );
+		for( size_t n=0; n<1000; n++ )
+			harbol_vector_insert(&r, &(union Value){.int64=n});
+		assert( r.table==reserved && r.len==1000 );
+		
+		harbol_vector_insert(&r, &(union Value){.int64=1000});
+		fprintf(g_harbol_debug_stream, "r's len after one more insert: '%zu'\n", r.len);
+		assert( r.len==harbol_grow_len(1000, 1001) && ((union Value *)harbol_vector_get(&r, 1000))->int64==1000 );
+		/* the realloc'd tail still has to read as zeroes. */
+		for( size_t n=r.count; n<r.len; n++ )
+			assert( ((union Value *)&r.table[n * r.datasize])->int64==0 );
+		harbol_vector_clear(&r, NULL);
+		
+		const size_t elems = 1 << 22;
+		const clock_t start = clock();
+		struct HarbolVector g = harbol_vector_create(sizeof(union Value), VEC_DEFAULT_SIZE);
+		for( size_t n=0; n<elems; n++ )
+			harbol_vector_insert(&g, &(union Value){.int64=n});
+		const clock_t end = clock();
+		fprintf(g_harbol_debug_stream, "vector :: growing to %zu elements took: %f\n", elems, (end-start)/(double)CLOCKS_PER_SEC);
+		harbol_vector_clear(&g, NULL);
+	}
+	
 	// free data
 	fputs("\nvector :: test destruction.\n", g_harbol_debug_stream);
 	
@@ -811,6 +1179,345 @@ void test_harbol_bytebuffer(void)
 		fprintf(g_harbol_debug_stream, "post-appending i[%zu]= %u\n", n, i.table[n]);
 	
 	
+	// test reserving.
+	fputs("\nbytebuffer :: test reserving.\n", g_harbol_debug_stream);
+	{
+		struct HarbolByteBuf r = harbol_bytebuffer_create();
+		const bool reserved_ok = harbol_bytebuffer_reserve(&r, 64);
+		assert( reserved_ok && harbol_bytebuffer_len(&r)==64 && r.count==0 );
+		const uint8_t *const reserved = r.table;
+		for( uint32_t n=0; n<15; n++ )
+			harbol_bytebuffer_insert_int32(&r, n);
+		assert( r.table==reserved && r.count==60 );
+		const bool smaller_ok = harbol_bytebuffer_reserve(&r, 8);
+		assert( smaller_ok && harbol_bytebuffer_len(&r)==64 );
+		harbol_bytebuffer_clear(&r);
+	}
+	
+	// test benchmarking appends.
+	fputs("\nbytebuffer :: benchmarking int32 appends.\n", g_harbol_debug_stream);
+	{
+		/* 16M values keeps the test suite's footprint sane, scale it up locally for bigger runs. */
+		const uint32_t values = 1u << 24;
+		struct HarbolByteBuf b = harbol_bytebuffer_create();
+		clock_t start = clock();
+		for( uint32_t n=0; n<values; n++ )
+			harbol_bytebuffer_insert_int32(&b, n);
+		clock_t end = clock();
+		fprintf(g_harbol_debug_stream, "checked inserts: %f | len: '%zu'\n", (end-start)/(double)CLOCKS_PER_SEC, harbol_bytebuffer_len(&b));
+		assert( b.count==values * sizeof(uint32_t) );
+		harbol_bytebuffer_clear(&b);
+		
+		start = clock();
+		harbol_bytebuffer_reserve(&b, values * sizeof(uint32_t));
+		for( uint32_t n=0; n<values; n++ )
+			harbol_bytebuffer_write_int32_unchecked(&b, n);
+		end = clock();
+		fprintf(g_harbol_debug_stream, "reserved + unchecked writes: %f\n", (end-start)/(double)CLOCKS_PER_SEC);
+		uint32_t last; memcpy(&last, &b.table[b.count - sizeof last], sizeof last);
+		assert( b.count==values * sizeof(uint32_t) && last==values - 1 );
+		
+		// test benchmarking reads of the same values.
+		fputs("\nbytebuffer :: benchmarking int32 reads.\n", g_harbol_debug_stream);
+		uint64_t sums[3] = {0};
+		start = clock();
+		for( size_t n=0; n<b.count; n += sizeof(uint32_t) ) {
+			uint32_t val; memcpy(&val, &harbol_bytebuffer_get_buffer(&b)[n], sizeof val);
+			sums[0] += val;
+		}
+		const double index_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		struct HarbolByteReader reader = harbol_bytebuffer_reader(&b, HarbolByteOrderNative);
+		for( uint32_t val; harbol_bytereader_read_int32(&reader, &val); )
+			sums[1] += val;
+		const double checked_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		reader = harbol_bytebuffer_reader(&b, HarbolByteOrderNative);
+		const bool has_all = harbol_bytereader_has(&reader, values * sizeof(uint32_t));
+		assert( has_all );
+		for( uint32_t n=0; n<values; n++ )
+			sums[2] += harbol_bytereader_read_int32_unchecked(&reader);
+		const double unchecked_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		fprintf(g_harbol_debug_stream, "manual indexing: %f | checked reads: %f | one check + unchecked reads: %f\n", index_time, checked_time, unchecked_time);
+		assert( sums[0]==sums[1] && sums[1]==sums[2] && sums[0]==(uint64_t)values * (values - 1) / 2 );
+		assert( harbol_bytereader_remaining(&reader)==0 );
+		harbol_bytebuffer_clear(&b);
+	}
+	
+	// test decoding a packet in place.
+	fputs("\nbytebuffer :: test reader cursor.\n", g_harbol_debug_stream);
+	{
+		struct HarbolByteBuf packet = harbol_bytebuffer_create();
+		harbol_bytebuffer_insert_byte(&packet, 7);
+		harbol_bytebuffer_insert_int16(&packet, 0x1234);
+		harbol_bytebuffer_insert_int32(&packet, 0xdeadbeef);
+		harbol_bytebuffer_insert_int64(&packet, 0x0102030405060708);
+		harbol_bytebuffer_insert_float32(&packet, 1.5f);
+		harbol_bytebuffer_insert_float64(&packet, -2.25);
+		harbol_bytebuffer_insert_cstr(&packet, "name");
+		harbol_bytebuffer_insert_obj(&packet, &(uint8_t[3]){ 9, 8, 7 }, 3);
+		
+		struct HarbolByteReader reader = harbol_bytebuffer_reader(&packet, HarbolByteOrderNative);
+		uint8_t u8 = 0; uint16_t u16 = 0; uint32_t u32 = 0; uint64_t u64 = 0;
+		float32_t f32 = 0; float64_t f64 = 0;
+		const bool read_u8 = harbol_bytereader_read_byte(&reader, &u8);
+		const bool read_u16 = harbol_bytereader_read_int16(&reader, &u16);
+		const bool read_u32 = harbol_bytereader_read_int32(&reader, &u32);
+		const bool read_u64 = harbol_bytereader_read_int64(&reader, &u64);
+		const bool read_f32 = harbol_bytereader_read_float32(&reader, &f32);
+		const bool read_f64 = harbol_bytereader_read_float64(&reader, &f64);
+		assert( read_u8 && u8==7 );
+		assert( read_u16 && u16==0x1234 );
+		assert( read_u32 && u32==0xdeadbeef );
+		assert( read_u64 && u64==0x0102030405060708 );
+		assert( read_f32 && f32==1.5f );
+		assert( read_f64 && f64==-2.25 );
+		
+		// strings & objects point into the buffer itself.
+		size_t name_len = 0;
+		const char *const name = harbol_bytereader_read_cstr(&reader, &name_len);
+		assert( name != NULL && name_len==4 && !strcmp(name, "name") );
+		assert( (const uint8_t *)name >= packet.table && (const uint8_t *)name < packet.table + packet.count );
+		const uint8_t *const obj = harbol_bytereader_read_obj(&reader, 3);
+		assert( obj==&packet.table[packet.count - 3] && obj[0]==9 && obj[2]==7 );
+		
+		// nothing is left, failed reads don't move the cursor.
+		assert( harbol_bytereader_remaining(&reader)==0 );
+		const bool read_past_end = harbol_bytereader_read_byte(&reader, &u8);
+		const char *const cstr_past_end = harbol_bytereader_read_cstr(&reader, NULL);
+		const uint8_t *const obj_past_end = harbol_bytereader_read_obj(&reader, 1);
+		assert( !read_past_end && cstr_past_end==NULL && obj_past_end==NULL );
+		reader.pos = packet.count - 2;
+		const bool read_short = harbol_bytereader_read_int32(&reader, &u32);
+		assert( !read_short && reader.pos==packet.count - 2 );
+		const bool skipped_past_end = harbol_bytereader_skip(&reader, 3);
+		const bool skipped_to_end = harbol_bytereader_skip(&reader, 2);
+		assert( !skipped_past_end && skipped_to_end );
+		
+		// an unterminated string isn't read past the end.
+		const char unterminated[] = { 'a', 'b', 'c' };
+		reader = harbol_bytereader_create(unterminated, sizeof unterminated, HarbolByteOrderNative);
+		const char *const unterminated_read = harbol_bytereader_read_cstr(&reader, NULL);
+		assert( unterminated_read==NULL && reader.pos==0 );
+		harbol_bytebuffer_clear(&packet);
+		
+		// fixed byte orders decode the same on any host.
+		const uint8_t wire[] = { 0x12, 0x34, 0xde, 0xad, 0xbe, 0xef, 0x3f, 0xc0, 0x00, 0x00 };
+		reader = harbol_bytereader_create(wire, sizeof wire, HarbolByteOrderBig);
+		const bool has_wire = harbol_bytereader_has(&reader, sizeof wire);
+		assert( has_wire );
+		const uint16_t big16 = harbol_bytereader_read_int16_unchecked(&reader);
+		const uint32_t big32 = harbol_bytereader_read_int32_unchecked(&reader);
+		assert( big16==0x1234 && big32==0xdeadbeef );
+		if( sizeof(float32_t)==4 ) {
+			const float32_t big_f32 = harbol_bytereader_read_float32_unchecked(&reader);
+			assert( big_f32==1.5f );
+		}
+		
+		reader = harbol_bytereader_create(wire, sizeof wire, HarbolByteOrderLittle);
+		const bool read_little16 = harbol_bytereader_read_int16(&reader, &u16);
+		const bool read_little32 = harbol_bytereader_read_int32(&reader, &u32);
+		assert( read_little16 && u16==0x3412 );
+		assert( read_little32 && u32==0xefbeadde );
+		fprintf(g_harbol_debug_stream, "same 2 bytes read as big endian: '0x%x' | as little endian: '0x%x'\n", big16, u16);
+	}
+	
+	// test varint & zigzag encoding.
+	fputs("\nbytebuffer :: test varints & zigzag.\n", g_harbol_debug_stream);
+	{
+		for( size_t bit=0; bit<64; bit++ ) {
+			const uint64_t edges[] = { (1ull << bit) - 1, 1ull << bit, (1ull << bit) + 1 };
+			for( size_t e=0; e<3; e++ ) {
+				size_t ref_len = 1;
+				for( uint64_t v=edges[e] >> 7; v != 0; v >>= 7 )
+					ref_len++;
+				assert( harbol_varint_len(edges[e])==ref_len );
+			}
+		}
+		assert( harbol_varint_len(0)==1 && harbol_varint_len(UINT64_MAX)==HARBOL_VARINT_MAX_LEN );
+		
+		const int64_t zz[] = { 0, -1, 1, -2, 2, INT64_MAX, INT64_MIN };
+		const uint64_t zz_enc[] = { 0, 1, 2, 3, 4, UINT64_MAX - 1, UINT64_MAX };
+		for( size_t n=0; n < sizeof zz / sizeof zz[0]; n++ ) {
+			const uint64_t enc = harbol_zigzag_encode(zz[n]);
+			const int64_t dec = harbol_zigzag_decode(zz_enc[n]);
+			assert( enc==zz_enc[n] && dec==zz[n] );
+		}
+		
+		struct HarbolByteBuf v = harbol_bytebuffer_create();
+		const bool put_300 = harbol_bytebuffer_insert_varint(&v, 300);
+		const bool put_neg64 = harbol_bytebuffer_insert_zigzag(&v, -64);
+		const bool put_max = harbol_bytebuffer_insert_varint(&v, UINT64_MAX);
+		assert( put_300 && put_neg64 && put_max );
+		assert( v.count==2 + 1 + 10 && v.table[0]==0xAC && v.table[1]==0x02 && v.table[2]==0x7F && v.table[v.count - 1]==0x01 );
+		
+		struct HarbolByteReader reader = harbol_bytebuffer_reader(&v, HarbolByteOrderNative);
+		uint64_t u = 0; int64_t i64 = 0;
+		const bool got_300 = harbol_bytereader_read_varint(&reader, &u);
+		assert( got_300 && u==300 );
+		const bool got_neg64 = harbol_bytereader_read_zigzag(&reader, &i64);
+		assert( got_neg64 && i64==-64 );
+		const bool got_max = harbol_bytereader_read_varint(&reader, &u);
+		assert( got_max && u==UINT64_MAX );
+		const bool got_past_end = harbol_bytereader_read_varint(&reader, &u);
+		assert( !got_past_end );
+		harbol_bytebuffer_clear(&v);
+		
+		// cut off, too long, and overflowing varints don't decode or move the cursor.
+		const uint8_t cut[] = { 0x80, 0x80 };
+		const uint8_t too_long[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+		const uint8_t overflow[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02 };
+		reader = harbol_bytereader_create(cut, sizeof cut, HarbolByteOrderNative);
+		const bool got_cut = harbol_bytereader_read_varint(&reader, &u);
+		assert( !got_cut && reader.pos==0 );
+		reader = harbol_bytereader_create(too_long, sizeof too_long, HarbolByteOrderNative);
+		const bool got_too_long = harbol_bytereader_read_varint(&reader, &u);
+		assert( !got_too_long && reader.pos==0 );
+		reader = harbol_bytereader_create(overflow, sizeof overflow, HarbolByteOrderNative);
+		const bool got_overflow = harbol_bytereader_read_varint(&reader, &u);
+		assert( !got_overflow && reader.pos==0 );
+		
+		// batches encode the same bytes as one at a time & shrink small values.
+		const size_t count = 1 << 20;
+		int64_t *const vals = harbol_alloc(count, sizeof *vals);
+		int64_t *const decoded = harbol_alloc(count, sizeof *decoded);
+		uint64_t seed = 0x9E3779B97F4A7C15;
+		for( size_t n=0; n<count; n++ ) {
+			seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+			/* mostly small deltas with the occasional huge one. */
+			vals[n] = ( n % 1000==0 ) ? (int64_t)seed : (int64_t)(seed % 2001) - 1000;
+		}
+		
+		struct HarbolByteBuf one = harbol_bytebuffer_create();
+		clock_t start = clock();
+		for( size_t n=0; n<count; n++ )
+			harbol_bytebuffer_insert_zigzag(&one, vals[n]);
+		const double single_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		struct HarbolByteBuf batch = harbol_bytebuffer_create();
+		start = clock();
+		const bool batch_put = harbol_bytebuffer_insert_zigzags(&batch, vals, count);
+		const double batch_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		assert( batch_put );
+		assert( one.count==batch.count && !memcmp(one.table, batch.table, one.count) );
+		
+		start = clock();
+		reader = harbol_bytebuffer_reader(&batch, HarbolByteOrderNative);
+		const bool batch_got = harbol_bytereader_read_zigzags(&reader, decoded, count);
+		const double decode_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		assert( batch_got && harbol_bytereader_remaining(&reader)==0 );
+		assert( !memcmp(vals, decoded, count * sizeof *vals) );
+		
+		// a batch that runs out partway doesn't move the cursor.
+		reader = harbol_bytereader_create(batch.table, batch.count - 1, HarbolByteOrderNative);
+		const bool short_batch_got = harbol_bytereader_read_zigzags(&reader, decoded, count);
+		assert( !short_batch_got && reader.pos==0 );
+		
+		fprintf(g_harbol_debug_stream, "%zu int64s :: fixed: %zu bytes | zigzag varints: %zu bytes | single inserts: %f | batch insert: %f | batch decode: %f\n", count, count * sizeof(int64_t), batch.count, single_time, batch_time, decode_time);
+		assert( batch.count < count * 2 );
+		harbol_bytebuffer_clear(&one);
+		harbol_bytebuffer_clear(&batch);
+		harbol_free(vals);
+		harbol_free(decoded);
+	}
+	
+	// test the segmented buffer.
+	fputs("\nbytebuffer :: test segmented buffer.\n", g_harbol_debug_stream);
+	{
+		const size_t total = HARBOL_SEGBUF_SEGMENT * 3 + HARBOL_SEGBUF_SEGMENT / 2;
+		uint8_t *const src = harbol_alloc(total, sizeof *src);
+		uint8_t *const dst = harbol_alloc(total, sizeof *dst);
+		for( size_t n=0; n<total; n++ )
+			src[n] = (uint8_t)(n * 31 + 7);
+		
+		struct HarbolSegBuf seg = harbol_segbuf_create();
+		const bool inserted = harbol_segbuf_insert_obj(&seg, src, total);
+		assert( inserted && harbol_segbuf_count(&seg)==total );
+		struct iovec iov[8];
+		const size_t iovs = harbol_segbuf_get_iovecs(&seg, iov, 8);
+		fprintf(g_harbol_debug_stream, "%zu bytes in %zu segments\n", harbol_segbuf_count(&seg), iovs);
+		assert( iovs==4 && iov[0].iov_len==HARBOL_SEGBUF_SEGMENT && iov[3].iov_len==HARBOL_SEGBUF_SEGMENT / 2 );
+		const size_t capped_iovs = harbol_segbuf_get_iovecs(&seg, iov, 2);
+		assert( capped_iovs==2 );
+		const bool peeked = harbol_segbuf_peek(&seg, dst, total);
+		assert( peeked && !memcmp(src, dst, total) );
+		const bool peeked_too_much = harbol_segbuf_peek(&seg, dst, total + 1);
+		assert( !peeked_too_much );
+		
+		// reads across a segment boundary, consumed segments get recycled.
+		const size_t first = HARBOL_SEGBUF_SEGMENT - 10;
+		const bool read_first = harbol_segbuf_read(&seg, dst, first);
+		assert( read_first && !memcmp(dst, src, first) );
+		const bool read_across = harbol_segbuf_read(&seg, dst, 20);
+		assert( read_across && !memcmp(dst, &src[first], 20) && seg.spare != NULL );
+		size_t front_len = 0;
+		const uint8_t *const front = harbol_segbuf_front(&seg, &front_len);
+		assert( front != NULL && front_len==HARBOL_SEGBUF_SEGMENT - 10 && *front==src[first + 20] );
+		const bool consumed_too_much = harbol_segbuf_consume(&seg, total);
+		assert( harbol_segbuf_count(&seg)==total - first - 20 && !consumed_too_much );
+		
+		// writev the rest out & consume what got written.
+		FILE *tmp = tmpfile();
+		if( tmp != NULL ) {
+			const size_t left = harbol_segbuf_count(&seg);
+			const ssize_t written = writev(fileno(tmp), iov, (int)harbol_segbuf_get_iovecs(&seg, iov, 8));
+			assert( written==(ssize_t)left );
+			const bool consumed = harbol_segbuf_consume(&seg, (size_t)written);
+			assert( consumed && harbol_segbuf_count(&seg)==0 );
+			rewind(tmp);
+			const size_t reread = fread(dst, 1, left, tmp);
+			assert( reread==left && !memcmp(dst, &src[first + 20], left) );
+			fclose(tmp);
+		}
+		const uint8_t *const empty_front = harbol_segbuf_front(&seg, &front_len);
+		const size_t empty_iovs = harbol_segbuf_get_iovecs(&seg, iov, 8);
+		assert( empty_front==NULL && empty_iovs==0 );
+		
+		// filling straight from a read.
+		size_t room = 0;
+		uint8_t *const write_to = harbol_segbuf_prepare(&seg, &room);
+		assert( write_to != NULL && room > 0 );
+		memcpy(write_to, "hello", 5);
+		const bool committed = harbol_segbuf_commit(&seg, 5);
+		const bool overcommitted = harbol_segbuf_commit(&seg, room);
+		assert( committed && !overcommitted );
+		const bool put_bang = harbol_segbuf_insert_byte(&seg, '!');
+		char hello[7] = {0};
+		const bool read_hello = harbol_segbuf_read(&seg, hello, 6);
+		assert( put_bang && read_hello && !strcmp(hello, "hello!") );
+		harbol_segbuf_clear(&seg);
+		assert( seg.head==NULL && seg.spare==NULL && harbol_segbuf_count(&seg)==0 );
+		
+		// benchmark a stream that's appended to the back & consumed from the front.
+		const size_t msg = 4096, backlog = 64, msgs = 8192;
+		struct HarbolByteBuf flat = harbol_bytebuffer_create();
+		clock_t start = clock();
+		for( size_t n=0; n<msgs; n++ ) {
+			harbol_bytebuffer_insert_obj(&flat, src, msg);
+			if( n >= backlog ) {
+				memcpy(dst, flat.table, msg);
+				harbol_bytebuffer_del(&flat, 0, msg);
+			}
+		}
+		const double flat_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		for( size_t n=0; n<msgs; n++ ) {
+			harbol_segbuf_insert_obj(&seg, src, msg);
+			if( n >= backlog )
+				harbol_segbuf_read(&seg, dst, msg);
+		}
+		const double seg_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		fprintf(g_harbol_debug_stream, "streaming %zu messages of %zu bytes with %zu queued :: bytebuffer: %f secs | segmented: %f secs\n", msgs, msg, backlog, flat_time, seg_time);
+		assert( flat.count==harbol_segbuf_count(&seg) && flat.count==backlog * msg );
+		harbol_bytebuffer_clear(&flat);
+		harbol_segbuf_clear(&seg);
+		harbol_free(src);
+		harbol_free(dst);
+	}
+	
 	// free data
 	fputs("\nbytebuffer :: test destruction.\n", g_harbol_debug_stream);
 	harbol_bytebuffer_clear(&i);
@@ -822,6 +1529,67 @@ void test_harbol_bytebuffer(void)
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
 
+static void __print_hash_chains(const char name[static 1], const size_t hashes[static 1], const size_t count, const size_t buckets)
+{
+	size_t *const chains = calloc(buckets, sizeof *chains);
+	assert( chains );
+	for( uindex_t i=0; i<count; i++ )
+		chains[hashes[i] & (buckets-1)]++;
+	
+	size_t longest = 0, empty = 0, probes = 0;
+	for( uindex_t i=0; i<buckets; i++ ) {
+		if( chains[i] > longest )
+			longest = chains[i];
+		if( chains[i]==0 )
+			empty++;
+		probes += chains[i] * (chains[i] + 1) / 2;
+	}
+	fprintf(g_harbol_debug_stream, "%s :: longest chain: %zu | empty buckets: %zu/%zu | avg probes per hit: %f\n", name, longest, empty, buckets, (double)probes / count);
+	free(chains);
+}
+
+void test_harbol_hash(void)
+{
+	fputs("hash :: test seeding & length variants.\n", g_harbol_debug_stream);
+	const char text[] = "section.subsection.key";
+	size_t len = 0;
+	const uint64_t seed = harbol_hash_seed();
+	const uint64_t cstr_hash = harbol_hash_cstr(text, seed, &len);
+	assert( cstr_hash==harbol_hash_bytes(text, sizeof text - 1, seed) );
+	assert( len==sizeof text - 1 );
+	assert( harbol_hash_bytes(text, len, 1) != harbol_hash_bytes(text, len, 2) );
+	assert( harbol_hash_bytes(text, len, seed) != harbol_hash_bytes(text, len - 1, seed) );
+	assert( harbol_hash_int(1, seed) != harbol_hash_int(2, seed) );
+	fprintf(g_harbol_debug_stream, "hash('%s') == %" PRIx64 " | seeded with %" PRIx64 "\n", text, harbol_hash_bytes(text, len, 0), seed);
+	
+	// compare the old shift/xor string hash with the seeded one on cfg style keys.
+	fputs("\nhash :: test bucket distribution & throughput on cfg-style keys.\n", g_harbol_debug_stream);
+	enum { KEYS = 100000, BUCKETS = 1 << 17, ROUNDS = 20 };
+	char (*const keys)[48] = calloc(KEYS, sizeof *keys);
+	size_t *const hashes = calloc(KEYS, sizeof *hashes);
+	assert( keys && hashes );
+	for( uindex_t i=0; i<KEYS; i++ )
+		sprintf(keys[i], "section%zu.subsection%zu.key%zu", i % 37, i % 101, i);
+	
+	clock_t start = clock();
+	for( uindex_t r=0; r<ROUNDS; r++ )
+		for( uindex_t i=0; i<KEYS; i++ )
+			hashes[i] = string_hash(keys[i]);
+	const double old_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+	__print_hash_chains("string_hash", hashes, KEYS, BUCKETS);
+	
+	start = clock();
+	for( uindex_t r=0; r<ROUNDS; r++ )
+		for( uindex_t i=0; i<KEYS; i++ )
+			hashes[i] = harbol_hash_cstr(keys[i], seed, NULL);
+	const double new_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+	__print_hash_chains("harbol_hash_cstr", hashes, KEYS, BUCKETS);
+	
+	fprintf(g_harbol_debug_stream, "string_hash: %f ns per key | harbol_hash_cstr: %f ns per key\n", old_time * 1e9 / (KEYS * ROUNDS), new_time * 1e9 / (KEYS * ROUNDS));
+	free(keys);
+	free(hashes);
+}
+
 void test_harbol_map(void)
 {
 	// Test allocation and initializations
@@ -866,6 +1634,199 @@ void test_harbol_map(void)
 	fprintf(g_harbol_debug_stream, "ptr[\"1\"] == %" PRIi64 "\n", ((union Value *)harbol_map_get(p, "1"))->int64);
 	fprintf(g_harbol_debug_stream, "ptr[\"2\"] == %p\n", harbol_map_get(p, "2"));
 	
+	// test growing and probing past deleted slots.
+	fputs("\nhashmap :: test bulk insertion & deletion.\n", g_harbol_debug_stream);
+	for( size_t n=0; n<1000; n++ ) {
+		char key[32] = {0};
+		sprintf(key, "section.key%zu", n);
+		harbol_map_insert(&i, key, &(union Value){.int64=n});
+	}
+	for( size_t n=0; n<1000; n += 2 ) {
+		char key[32] = {0};
+		sprintf(key, "section.key%zu", n);
+		const bool deleted = harbol_map_del(&i, key, NULL);
+		assert( deleted );
+	}
+	for( size_t n=0; n<1000; n++ ) {
+		char key[32] = {0};
+		sprintf(key, "section.key%zu", n);
+		const union Value *const v = harbol_map_get(&i, key);
+		assert( (n & 1) ? v != NULL && v->int64==(int64_t)n : v==NULL );
+	}
+	fprintf(g_harbol_debug_stream, "i's count: %zu | len: %zu\n", i.count, i.len);
+	
+	// test find-or-insert entries.
+	fputs("\nhashmap :: test entry counting.\n", g_harbol_debug_stream);
+	const char *words[] = { "a", "b", "a", "c", "a", "b" };
+	for( const char **w=&words[0]; w<1[&words]; w++ ) {
+		bool inserted = false;
+		union Value *const v = harbol_map_entry(&i, *w, &inserted);
+		assert( v != NULL );
+		if( inserted )
+			assert( v->int64==0 );
+		v->int64++;
+	}
+	fprintf(g_harbol_debug_stream, "stk[\"a\"] == %" PRIi64 " | stk[\"b\"] == %" PRIi64 " | stk[\"c\"] == %" PRIi64 "\n", ((union Value *)harbol_map_get(&i, "a"))->int64, ((union Value *)harbol_map_get(&i, "b"))->int64, ((union Value *)harbol_map_get(&i, "c"))->int64);
+	const bool reinserted = harbol_map_insert(&i, "a", &(union Value){.int64=0});
+	assert( !reinserted );
+	
+	// test inserting a standalone key-value pair.
+	fputs("\nhashmap :: test key-value pair insertion.\n", g_harbol_debug_stream);
+	struct HarbolKeyVal *kv = harbol_kvpair_new("kvpair", &(union Value){.int64=77}, sizeof(union Value));
+	assert( kv );
+	const bool kv_inserted = harbol_map_insert_kv(&i, kv);
+	assert( kv_inserted );
+	assert( harbol_map_get_kv(&i, "kvpair")==kv );
+	fprintf(g_harbol_debug_stream, "stk[\"%s\"] (key len %zu) == %" PRIi64 "\n", harbol_string_cstr(&kv->key), harbol_string_len(&kv->key), ((union Value *)kv->data)->int64);
+	
+	// test incremental rehashing, lookups have to see keys in both tables mid-migration.
+	fputs("\nhashmap :: test incremental rehashing.\n", g_harbol_debug_stream);
+	{
+		struct HarbolMap inc = harbol_map_create(sizeof(union Value));
+		harbol_map_set_rehash_step(&inc, 4);
+		size_t migrations = 0;
+		for( size_t n=0; n<2000; n++ ) {
+			char key[32] = {0};
+			sprintf(key, "inc.key%zu", n);
+			const bool inserted = harbol_map_insert(&inc, key, &(union Value){.int64=n});
+			assert( inserted );
+			if( inc.old.buckets != NULL ) {
+				migrations++;
+				sprintf(key, "inc.key%zu", n >> 1);
+				assert( ((union Value *)harbol_map_get(&inc, key))->int64==(int64_t)(n >> 1) );
+			}
+		}
+		for( size_t n=0; n<2000; n += 3 ) {
+			char key[32] = {0};
+			sprintf(key, "inc.key%zu", n);
+			const bool deleted = harbol_map_del(&inc, key, NULL);
+			assert( deleted );
+		}
+		fprintf(g_harbol_debug_stream, "inc's count: %zu | len: %zu | inserts made mid-migration: %zu\n", inc.count, inc.len, migrations);
+		harbol_map_clear(&inc, NULL);
+		
+		/* churn keeps the count low until tombstones force a same size rehash, that has the least headroom to migrate in.
+		 * after it only inserts pay for the migration, which still has to be done by the time the next grow comes.
+		 */
+		harbol_map_set_rehash_step(&inc, 1);
+		size_t n = 0;
+		bool same_size = false;
+		for( ; !same_size && n<1000000; n++ ) {
+			const size_t len = inc.len;
+			const void *const table = inc.buckets;
+			char key[32] = {0};
+			sprintf(key, "churn.key%zu", n);
+			const bool inserted = harbol_map_insert(&inc, key, &(union Value){.int64=n});
+			assert( inserted );
+			same_size = (const void *)inc.buckets != table && len==inc.len && len > 0;
+			if( !same_size && n >= 100 ) {
+				sprintf(key, "churn.key%zu", n - 100);
+				const bool deleted = harbol_map_del(&inc, key, NULL);
+				assert( deleted );
+			}
+		}
+		assert( same_size );
+		size_t left = 0, step = 0, inserts = 0;
+		for( bool grew = false; !grew; n++, inserts++ ) {
+			left = (inc.old.buckets==NULL) ? 0 : inc.old.len - inc.old.cursor;
+			step = inc.old.step;
+			const void *const table = inc.buckets;
+			char key[32] = {0};
+			sprintf(key, "churn.key%zu", n);
+			const bool inserted = harbol_map_insert(&inc, key, &(union Value){.int64=n});
+			assert( inserted );
+			grew = (const void *)inc.buckets != table;
+		}
+		fprintf(g_harbol_debug_stream, "inserts after a same size rehash until the next grow: %zu | old slots left then: %zu | step: %zu\n", inserts, left, step);
+		assert( left <= step );
+		harbol_map_clear(&inc, NULL);
+	}
+	
+	// test batched lookups against a loop of single lookups.
+	fputs("\nhashmap :: test & benchmark batched lookups.\n", g_harbol_debug_stream);
+	{
+		const size_t keys = 200000;
+		struct HarbolMap big = harbol_map_create(sizeof(union Value));
+		char (*const names)[32] = harbol_alloc(keys, sizeof *names);
+		const char **const lookups = harbol_alloc(keys, sizeof *lookups);
+		void **const results = harbol_alloc(keys, sizeof *results);
+		assert( names && lookups && results );
+		for( size_t n=0; n<keys; n++ ) {
+			sprintf(names[n], "batch.key%zu", n);
+			harbol_map_insert(&big, names[n], &(union Value){.int64=n});
+		}
+		/* scatter the lookups so consecutive keys don't share cache lines. */
+		for( size_t n=0; n<keys; n++ )
+			lookups[n] = names[(n * 7919) % keys];
+		lookups[0] = "not a key";
+		
+		int64_t sum = 0;
+		clock_t start = clock();
+		for( size_t n=0; n<keys; n++ ) {
+			const union Value *const v = harbol_map_get(&big, lookups[n]);
+			if( v != NULL )
+				sum += v->int64;
+		}
+		const double loop_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		const size_t found = harbol_map_get_many(&big, lookups, keys, results);
+		for( size_t n=0; n<keys; n++ )
+			if( results[n] != NULL )
+				sum -= ((const union Value *)results[n])->int64;
+		const double batch_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		assert( found==keys - 1 && results[0]==NULL && sum==0 );
+		fprintf(g_harbol_debug_stream, "%zu lookups :: harbol_map_get loop: %f secs | harbol_map_get_many: %f secs\n", keys, loop_time, batch_time);
+		harbol_free(names);
+		harbol_free(lookups);
+		harbol_free(results);
+		harbol_map_clear(&big, NULL);
+	}
+	
+	// test lookups by views over a source buffer.
+	fputs("\nhashmap :: test & benchmark view lookups.\n", g_harbol_debug_stream);
+	{
+		const char src[] = "3 10 77";
+		const struct HarbolStrView three = { src, 1 }, ten = { &src[2], 2 };
+		assert( harbol_map_has_key_view(&i, three) && ((union Value *)harbol_map_get_view(&i, ten))->int64==10 );
+		assert( !harbol_map_has_key_view(&i, (struct HarbolStrView){ &src[5], 2 }) && harbol_map_get_kv_view(&i, ten)==harbol_map_get_kv(&i, "10") );
+		
+		// count words in a text, slicing views out of it vs copying each word out first.
+		struct HarbolString text = EMPTY_HARBOL_STRING;
+		const size_t words = 1 << 18;
+		for( size_t n=0; n<words; n++ )
+			harbol_string_add_format(&text, "word%zu ", n % 1000);
+		
+		struct HarbolMap counts = harbol_map_create(sizeof(size_t));
+		clock_t start = clock();
+		for( const char *iter = harbol_string_cstr(&text); *iter != 0; ) {
+			const char *const word = iter;
+			while( *iter != ' ' )
+				iter++;
+			++*(size_t *)harbol_map_entry_view(&counts, (struct HarbolStrView){ word, (size_t)(iter++ - word) }, NULL);
+		}
+		const double view_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		assert( counts.count==1000 && *(size_t *)harbol_map_get(&counts, "word999")==words / 1000 );
+		harbol_map_clear(&counts, NULL);
+		
+		counts = harbol_map_create(sizeof(size_t));
+		start = clock();
+		struct HarbolString word = EMPTY_HARBOL_STRING;
+		for( const char *iter = harbol_string_cstr(&text); *iter != 0; iter++ ) {
+			harbol_string_clear(&word);
+			while( *iter != ' ' )
+				harbol_string_add_char(&word, *iter++);
+			++*(size_t *)harbol_map_entry(&counts, harbol_string_cstr(&word), NULL);
+		}
+		const double copy_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		assert( counts.count==1000 );
+		fprintf(g_harbol_debug_stream, "counting %zu words :: view lookups: %f secs | copied keys: %f secs\n", words, view_time, copy_time);
+		harbol_string_clear(&word);
+		harbol_map_clear(&counts, NULL);
+		harbol_string_clear(&text);
+	}
+	
 	// free data
 	fputs("\nhashmap :: test destruction.\n", g_harbol_debug_stream);
 	harbol_map_clear(&i, NULL);
@@ -878,6 +1839,222 @@ void test_harbol_map(void)
 }
 
 
+void test_harbol_intmap(void)
+{
+	// Test allocation and initializations
+	fputs("intmap :: test allocation & initialization.\n", g_harbol_debug_stream);
+	struct HarbolIntMap *p = harbol_intmap_new(sizeof(uint64_t));
+	assert( p );
+	
+	struct HarbolIntMap i = harbol_intmap_create(sizeof(uint64_t));
+	
+	// test insertion, retrieval, & setting.
+	fputs("\nintmap :: test insertion, retrieval, & setting.\n", g_harbol_debug_stream);
+	for( uint64_t n=0; n<10; n++ ) {
+		const bool ptr_inserted = harbol_intmap_insert(p, n+1, &(uint64_t){n+1});
+		const bool stk_inserted = harbol_intmap_insert(&i, n+1, &(uint64_t){n+1});
+		assert( ptr_inserted && stk_inserted );
+	}
+	const bool reinserted = harbol_intmap_insert(&i, 1, &(uint64_t){0});
+	assert( !reinserted );
+	harbol_intmap_set(p, 2, &(uint64_t){20});
+	harbol_intmap_set(&i, 2, &(uint64_t){200});
+	for( uint64_t n=0; n<10; n++ ) {
+		fprintf(g_harbol_debug_stream, "ptr[%" PRIu64 "] == %" PRIu64 "\n", n+1, *(uint64_t *)harbol_intmap_get(p, n+1));
+		fprintf(g_harbol_debug_stream, "stk[%" PRIu64 "] == %" PRIu64 "\n\n", n+1, *(uint64_t *)harbol_intmap_get(&i, n+1));
+	}
+	
+	// test pointer keys.
+	fputs("\nintmap :: test pointer keys.\n", g_harbol_debug_stream);
+	const char *names[] = { "kek", "lel", "foo" };
+	for( uindex_t n=0; n<1[&names] - &names[0]; n++ )
+		harbol_intmap_insert(&i, (uintptr_t)names[n], &(uint64_t){n});
+	for( uindex_t n=0; n<1[&names] - &names[0]; n++ ) {
+		assert( harbol_intmap_has_key(&i, (uintptr_t)names[n]) );
+		fprintf(g_harbol_debug_stream, "stk[%p (%s)] == %" PRIu64 "\n", (void *)names[n], names[n], *(uint64_t *)harbol_intmap_get(&i, (uintptr_t)names[n]));
+	}
+	
+	// test deletion, growing, & probing past deleted slots.
+	fputs("\nintmap :: test bulk insertion & deletion.\n", g_harbol_debug_stream);
+	for( uint64_t n=100; n<5100; n++ ) {
+		const bool inserted = harbol_intmap_insert(&i, n * 0x10000, &(uint64_t){n});
+		assert( inserted );
+	}
+	for( uint64_t n=100; n<5100; n += 2 ) {
+		const bool deleted = harbol_intmap_del(&i, n * 0x10000, NULL);
+		assert( deleted );
+	}
+	for( uint64_t n=100; n<5100; n++ ) {
+		const uint64_t *const v = harbol_intmap_get(&i, n * 0x10000);
+		assert( (n & 1) ? v != NULL && *v==n : v==NULL );
+	}
+	size_t walked = 0;
+	for( uindex_t n=0; n<i.len; n++ )
+		if( i.ctrl[n] < 0x80 )
+			walked++;
+	assert( walked==i.count );
+	fprintf(g_harbol_debug_stream, "i's count: %zu | len: %zu | tombs: %zu\n", i.count, i.len, i.tombs);
+	
+	// compare against formatting integers into strings for the string map.
+	fputs("\nintmap :: benchmarking against sprintf'd keys in a string map.\n", g_harbol_debug_stream);
+	{
+		const size_t keys = 200000;
+		struct HarbolMap strmap = harbol_map_create(sizeof(uint64_t));
+		struct HarbolIntMap intmap = harbol_intmap_create(sizeof(uint64_t));
+		
+		clock_t start = clock();
+		for( size_t n=0; n<keys; n++ ) {
+			char key[32] = {0};
+			sprintf(key, "%zu", n);
+			harbol_map_insert(&strmap, key, &(uint64_t){n});
+		}
+		for( size_t n=0; n<keys; n++ ) {
+			char key[32] = {0};
+			sprintf(key, "%zu", n);
+			assert( *(uint64_t *)harbol_map_get(&strmap, key)==n );
+		}
+		const double str_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		for( size_t n=0; n<keys; n++ )
+			harbol_intmap_insert(&intmap, n, &(uint64_t){n});
+		for( size_t n=0; n<keys; n++ )
+			assert( *(uint64_t *)harbol_intmap_get(&intmap, n)==n );
+		const double int_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		fprintf(g_harbol_debug_stream, "%zu inserts + gets :: string map: %f secs | int map: %f secs\n", keys, str_time, int_time);
+		harbol_map_clear(&strmap, NULL);
+		harbol_intmap_clear(&intmap, NULL);
+	}
+	
+	// free data
+	fputs("\nintmap :: test destruction.\n", g_harbol_debug_stream);
+	harbol_intmap_clear(&i, NULL);
+	fprintf(g_harbol_debug_stream, "i's slots are null? '%s'\n", i.slots ? "no" : "yes");
+	harbol_intmap_free(&p, NULL);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+}
+
+
+enum { CONCMAP_BENCH_KEYS = 50000, CONCMAP_BENCH_OPS = 200000 };
+
+struct ConcMapBench {
+	struct HarbolConcMap *cmap;
+	struct HarbolMap *map;
+	pthread_mutex_t *mutex;
+	char (*names)[32];
+	size_t id;
+};
+
+static void *__concmap_bench_thread(void *const arg)
+{
+	const struct ConcMapBench *const b = arg;
+	size_t x = b->id * 0x9E3779B97F4A7C15ull + 1;
+	union Value v = {0};
+	for( size_t n=0; n<CONCMAP_BENCH_OPS; n++ ) {
+		x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+		const char *const key = b->names[x % CONCMAP_BENCH_KEYS];
+		/* 1 in 100 ops is a write. */
+		const bool write = (x >> 40) % 100==0;
+		if( b->cmap != NULL ) {
+			if( write )
+				harbol_concmap_set(b->cmap, key, &(union Value){.int64=n});
+			else harbol_concmap_get(b->cmap, key, &v);
+		} else {
+			pthread_mutex_lock(b->mutex);
+			if( write )
+				harbol_map_set(b->map, key, &(union Value){.int64=n});
+			else {
+				const union Value *const p = harbol_map_get(b->map, key);
+				if( p != NULL )
+					v = *p;
+			}
+			pthread_mutex_unlock(b->mutex);
+		}
+	}
+	return NULL;
+}
+
+static double __concmap_bench_run(struct ConcMapBench bench, const size_t threads)
+{
+	pthread_t tids[16];
+	struct ConcMapBench args[16];
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for( size_t t=0; t<threads; t++ ) {
+		args[t] = bench;
+		args[t].id = t;
+		pthread_create(&tids[t], NULL, __concmap_bench_thread, &args[t]);
+	}
+	for( size_t t=0; t<threads; t++ )
+		pthread_join(tids[t], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	const double secs = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	return (threads * CONCMAP_BENCH_OPS) / secs / 1e6;
+}
+
+void test_harbol_concmap(void)
+{
+	// Test allocation and initializations
+	fputs("concmap :: test allocation & initialization.\n", g_harbol_debug_stream);
+	struct HarbolConcMap *p = harbol_concmap_new(sizeof(union Value), 0);
+	assert( p && p->shard_count==HARBOL_CONCMAP_DEFAULT_SHARDS );
+	struct HarbolConcMap i = harbol_concmap_create(sizeof(union Value), 10);
+	assert( i.shard_count==16 && ((uintptr_t)i.shards & 63)==0 );
+	
+	// test insertion, retrieval, setting, & deletion.
+	fputs("\nconcmap :: test insertion, retrieval, setting, & deletion.\n", g_harbol_debug_stream);
+	for( size_t n=0; n<1000; n++ ) {
+		char key[32] = {0};
+		sprintf(key, "conc.key%zu", n);
+		const bool inserted = harbol_concmap_insert(&i, key, &(union Value){.int64=n});
+		assert( inserted );
+	}
+	const bool reinserted = harbol_concmap_insert(&i, "conc.key0", &(union Value){.int64=0});
+	assert( !reinserted );
+	harbol_concmap_set(&i, "conc.key1", &(union Value){.int64=100});
+	union Value v = {0};
+	const bool got = harbol_concmap_get(&i, "conc.key1", &v);
+	assert( got && v.int64==100 );
+	const bool deleted = harbol_concmap_del(&i, "conc.key1", NULL);
+	assert( deleted && !harbol_concmap_has_key(&i, "conc.key1") );
+	const bool got_deleted = harbol_concmap_get(&i, "conc.key1", &v);
+	assert( !got_deleted );
+	fprintf(g_harbol_debug_stream, "i's count: %zu\n", harbol_concmap_count(&i));
+	
+	// test benchmarking reads with occasional writes against a global mutex.
+	fputs("\nconcmap :: benchmarking 99% reads / 1% writes against a mutex-wrapped hashmap.\n", g_harbol_debug_stream);
+	{
+		char (*const names)[32] = harbol_alloc(CONCMAP_BENCH_KEYS, sizeof *names);
+		struct HarbolMap map = harbol_map_create(sizeof(union Value));
+		pthread_mutex_t mutex;
+		pthread_mutex_init(&mutex, NULL);
+		assert( names );
+		for( size_t n=0; n<CONCMAP_BENCH_KEYS; n++ ) {
+			sprintf(names[n], "bench.key%zu", n);
+			harbol_concmap_insert(p, names[n], &(union Value){.int64=n});
+			harbol_map_insert(&map, names[n], &(union Value){.int64=n});
+		}
+		for( size_t threads=1; threads<=8; threads <<= 1 ) {
+			const double locked = __concmap_bench_run((struct ConcMapBench){ NULL, &map, &mutex, names, 0 }, threads);
+			const double striped = __concmap_bench_run((struct ConcMapBench){ p, NULL, NULL, names, 0 }, threads);
+			fprintf(g_harbol_debug_stream, "%zu thread(s) :: global mutex: %.2f Mops/s | concmap: %.2f Mops/s\n", threads, locked, striped);
+		}
+		assert( harbol_concmap_count(p)==CONCMAP_BENCH_KEYS );
+		pthread_mutex_destroy(&mutex);
+		harbol_map_clear(&map, NULL);
+		harbol_free(names);
+	}
+	
+	// free data
+	fputs("\nconcmap :: test destruction.\n", g_harbol_debug_stream);
+	harbol_concmap_clear(&i, NULL);
+	fprintf(g_harbol_debug_stream, "i's shards are null? '%s'\n", i.shards ? "no" : "yes");
+	harbol_concmap_free(&p, NULL);
+	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
+}
+
+
 void test_harbol_mempool(void)
 {
 	if( !g_harbol_debug_stream )
@@ -1108,6 +2285,40 @@ void test_harbol_mempool(void)
 	
 	const clock_t end = clock();
 	printf("memory pool run time: %f\n", (end-start)/(double)CLOCKS_PER_SEC);
+	
+	// test giving a container its own pool instead of the global one.
+	fputs("\nmempool :: test creating containers with a mempool allocator.\n", g_harbol_debug_stream);
+	{
+		struct HarbolMemPool pool = harbol_mempool_create(1 << 16);
+		const struct HarbolAllocator a = harbol_mempool_allocator(&pool);
+		const size_t before = harbol_mempool_mem_remaining(&pool);
+		
+		struct HarbolMap map = harbol_map_create_with(sizeof(union Value), &a);
+		struct HarbolString str = harbol_string_create_with("pooled", &a);
+		for( size_t n=0; n<50; n++ ) {
+			harbol_string_format(&str, "pool.key%zu", n);
+			harbol_map_insert(&map, harbol_string_cstr(&str), &(union Value){.int64=n});
+		}
+		assert( map.count==50 && ((union Value *)harbol_map_get(&map, "pool.key49"))->int64==49 );
+		assert( harbol_mempool_mem_remaining(&pool) < before );
+		
+		// a standalone pair has to come from the map's own allocator since the map frees it.
+		struct HarbolKeyVal *const kv = harbol_kvpair_new_with(&a, "pool.kv", &(union Value){.int64=-1}, sizeof(union Value));
+		assert( kv );
+		const bool kv_inserted = harbol_map_insert_kv(&map, kv);
+		assert( kv_inserted && harbol_map_get_kv(&map, "pool.kv")==kv );
+		
+		// a size that wraps never reaches the allocator.
+		const size_t remaining = harbol_mempool_mem_remaining(&pool);
+		assert( harbol_alloc_with(&a, SIZE_MAX / 8 + 2, 8)==NULL && harbol_mempool_mem_remaining(&pool)==remaining );
+		
+		harbol_map_clear(&map, NULL);
+		harbol_string_clear(&str);
+		harbol_mempool_defrag(&pool);
+		fprintf(g_harbol_debug_stream, "pool mem remaining after clearing containers: '%zu' / '%zu'\n", harbol_mempool_mem_remaining(&pool), before);
+		harbol_mempool_clear(&pool);
+	}
+	
 	// free data
 	fputs("\nmempool :: test destruction.\n", g_harbol_debug_stream);
 	harbol_mempool_clear(&i);
@@ -1192,6 +2403,55 @@ void test_harbol_cache(void)
 	(*v)[2] = 10.;
 	fprintf(g_harbol_debug_stream, "remaining cache mem: '%zu'\nf value: %" PRIf32 "\nvec values: { %" PRIf64 ", %" PRIf64 ", %" PRIf64 " } | is aligned? %u\n", harbol_cache_remaining(&i), *f, (*v)[0], (*v)[1], (*v)[2], is_aligned(v, sizeof(uintptr_t)));
 	
+	// test using the cache as an arena for containers.
+	fputs("\ncache :: test creating containers with a cache allocator.\n", g_harbol_debug_stream);
+	{
+		struct HarbolCache arena = harbol_cache_create(1 << 16);
+		const struct HarbolAllocator a = harbol_cache_allocator(&arena);
+		const uintptr_t lo = (uintptr_t)arena.base, hi = (uintptr_t)arena.offset;
+#		define IN_ARENA(p)    ((uintptr_t)(p) >= lo && (uintptr_t)(p) < hi)
+		
+		struct HarbolVector vec = harbol_vector_create_with(sizeof(union Value), 4, &a);
+		for( size_t n=0; n<100; n++ )
+			harbol_vector_insert(&vec, &(union Value){.int64=n});
+		assert( IN_ARENA(vec.table) && ((union Value *)harbol_vector_get(&vec, 99))->int64==99 );
+		
+		struct HarbolMap map = harbol_map_create_with(sizeof(union Value), &a);
+		for( size_t n=0; n<100; n++ ) {
+			char key[32] = {0};
+			sprintf(key, "arena.key%zu", n);
+			harbol_map_insert(&map, key, &(union Value){.int64=n});
+		}
+		union Value *const mv = harbol_map_get(&map, "arena.key42");
+		assert( IN_ARENA(map.buckets) && IN_ARENA(mv) && mv->int64==42 );
+		
+		struct HarbolString str = harbol_string_create_with("short lived ", &a);
+		harbol_string_add_cstr(&str, "request data");
+		assert( IN_ARENA(harbol_string_cstr(&str)) && !harbol_string_cmpcstr(&str, "short lived request data") );
+		
+		struct HarbolByteBuf buf = harbol_bytebuffer_create_with(&a);
+		harbol_bytebuffer_insert_int64(&buf, 0x1122334455667788ull);
+		assert( IN_ARENA(buf.table) && buf.count==8 );
+		
+		struct HarbolUniList list = harbol_unilist_create_with(sizeof(union Value), &a);
+		harbol_unilist_insert_at_tail(&list, &(union Value){.int64=7});
+		assert( IN_ARENA(list.head) && IN_ARENA(list.head->data) );
+		
+		struct HarbolTree tree = harbol_tree_create_with(&(union Value){.int64=1}, sizeof(union Value), &a);
+		harbol_tree_insert_child_val(&tree, &(union Value){.int64=2}, sizeof(union Value));
+		assert( IN_ARENA(tree.data) && IN_ARENA(harbol_tree_index_get_child(&tree, 0)->data) );
+		
+		struct HarbolGraph graph = harbol_graph_create_with(sizeof(union Value), sizeof(union Value), &a);
+		harbol_graph_add_vert(&graph, &(union Value){.int64=1});
+		harbol_graph_index_add_edge(&graph, 0, 0, &(union Value){.int64=5});
+		assert( IN_ARENA(harbol_graph_get_vert(&graph, 0)->data) && IN_ARENA(harbol_graph_index_get_edge(&graph, 0, 0)->weight) );
+#		undef IN_ARENA
+		
+		fprintf(g_harbol_debug_stream, "arena mem used by the containers: '%zu'\n", (size_t)(hi - lo) - harbol_cache_remaining(&arena));
+		/* no need to clear each container, the whole arena goes at once. */
+		harbol_cache_clear(&arena);
+	}
+	
 	// free data
 	fputs("\ncache :: test destruction.\n", g_harbol_debug_stream);
 	harbol_cache_clear(&i);
@@ -1393,12 +2653,12 @@ void test_harbol_tree(void)
 	str = harbol_string_create("else");
 	harbol_tree_insert_child_val(harbol_tree_index_get_child(p, 0), &str, hstr_size);
 	
-	fprintf(g_harbol_debug_stream, "p's data: '%s'\n", ((struct HarbolString *)p->data)->cstr);
+	fprintf(g_harbol_debug_stream, "p's data: '%s'\n", harbol_string_cstr((struct HarbolString *)p->data));
 	struct HarbolTree *kid = harbol_tree_index_get_child(p, 0);
-	fprintf(g_harbol_debug_stream, "p's child data: '%s'\n", ((struct HarbolString *)kid->data)->cstr);
+	fprintf(g_harbol_debug_stream, "p's child data: '%s'\n", harbol_string_cstr((struct HarbolString *)kid->data));
 	for( uindex_t n=0; n<kid->children.count; n++ ) {
 		struct HarbolTree *child = harbol_tree_index_get_child(kid, n);
-		fprintf(g_harbol_debug_stream, "p's child's children data: '%s'\n", ((struct HarbolString *)child->data)->cstr);
+		fprintf(g_harbol_debug_stream, "p's child's children data: '%s'\n", harbol_string_cstr((struct HarbolString *)child->data));
 	}
 	
 	fprintf(g_harbol_debug_stream, "\nfreeing string data. %u\n", harbol_tree_clear(p, &__free_string)); //(void(*)(void**))harbol_string_free));
@@ -1454,7 +2714,7 @@ void test_harbol_linkmap(void)
 	fprintf(g_harbol_debug_stream, "stk[\"2\"] == %" PRIi64 "\n", ((union Value *)harbol_linkmap_key_get(&i, "2"))->int64);
 	
 	fputs("\nlinkmap :: looping through all data.\n", g_harbol_debug_stream);
-	for( uindex_t n=0; n<i.vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(&i); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(&i, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
@@ -1467,12 +2727,12 @@ void test_harbol_linkmap(void)
 	fprintf(g_harbol_debug_stream, "stk[\"1\"] == %" PRIi64 "\n", ((union Value *)harbol_linkmap_key_get(&i, "1"))->int64);
 	fprintf(g_harbol_debug_stream, "stk[\"2\"] == %" PRIi64 "\n", ((union Value *)harbol_linkmap_key_get(&i, "2"))->int64);
 	fputs("\nlinkmap :: looping through all data.\n", g_harbol_debug_stream);
-	for( uindex_t n=0; n<i.vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(&i); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(&i, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
 	fputs("\n", g_harbol_debug_stream);
-	for( uindex_t n=0; n<p->vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(p); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(p, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
@@ -1482,23 +2742,90 @@ void test_harbol_linkmap(void)
 	harbol_linkmap_key_del(p, "2", NULL);
 	fprintf(g_harbol_debug_stream, "ptr[\"2\"] == %p\n", harbol_linkmap_key_get(p, "2"));
 	fputs("\nlinkmap :: looping through all data.\n", g_harbol_debug_stream);
-	for( uindex_t n=0; n<p->vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(p); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(p, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
 	fputs("\nlinkmap :: test item deletion by index.\n", g_harbol_debug_stream);
 	harbol_linkmap_index_del(p, 2, NULL);
-	for( uindex_t n=0; n<p->vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(p); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(p, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
 	// test setting by index
 	fputs("\nlinkmap :: test item setting by index.\n", g_harbol_debug_stream);
 	harbol_linkmap_index_set(p, 2, &(union Value){.int64=500});
-	for( uindex_t n=0; n<p->vec.count; n++ ) {
+	for( uindex_t n=0; n<harbol_linkmap_count(p); n++ ) {
 		struct HarbolKeyVal *l = harbol_linkmap_index_get_kv(p, n);
 		fprintf(g_harbol_debug_stream, "l's value == %" PRIi64 "\n", ((union Value *)l->data)->int64);
 	}
+	// test bulk deletion keeps insertion order & indices consistent across compactions.
+	fputs("\nlinkmap :: test bulk insertion & deletion.\n", g_harbol_debug_stream);
+	{
+		struct HarbolLinkMap bulk = harbol_linkmap_create(sizeof(union Value));
+		const clock_t start = clock();
+		for( size_t n=0; n<20000; n++ ) {
+			char key[32] = {0};
+			sprintf(key, "bulk.key%zu", n);
+			const bool inserted = harbol_linkmap_insert(&bulk, key, &(union Value){.int64=n});
+			assert( inserted );
+		}
+		for( size_t n=0; n<20000; n++ ) {
+			if( n % 3==0 )
+				continue;
+			char key[32] = {0};
+			sprintf(key, "bulk.key%zu", n);
+			const bool deleted = harbol_linkmap_key_del(&bulk, key, NULL);
+			assert( deleted );
+		}
+		for( size_t n=0; n<20000; n += 3 ) {
+			char key[32] = {0};
+			sprintf(key, "bulk.key%zu", n);
+			const index_t index = harbol_linkmap_get_key_index(&bulk, key);
+			assert( index==(index_t)(n / 3) );
+			assert( ((union Value *)harbol_linkmap_index_get(&bulk, index))->int64==(int64_t)n );
+		}
+		/* iterators can still hand out holes, the live pairs come out in insertion order. */
+		size_t live = 0;
+		struct HarbolKeyVal **const end = harbol_linkmap_get_iter_end_count(&bulk);
+		for( struct HarbolKeyVal **iter = harbol_linkmap_get_iter(&bulk); iter && iter<end; iter++ ) {
+			if( *iter==NULL )
+				continue;
+			assert( ((union Value *)(*iter)->data)->int64==(int64_t)(live * 3) );
+			live++;
+		}
+		assert( live==harbol_linkmap_count(&bulk) );
+		fprintf(g_harbol_debug_stream, "bulk's count: %zu | entries: %zu | index len: %zu | time: %f secs\n", harbol_linkmap_count(&bulk), bulk.vec.count, bulk.len, (clock() - start) / (double)CLOCKS_PER_SEC);
+		harbol_linkmap_clear(&bulk, NULL);
+	}
+	
+	// benchmark deleting in & against insertion order, time per delete should stay flat as the map grows.
+	fputs("\nlinkmap :: benchmarking deletion.\n", g_harbol_debug_stream);
+	for( size_t keys=50000; keys<=800000; keys *= 4 ) {
+		double times[2] = {0};
+		for( size_t reverse=0; reverse<2; reverse++ ) {
+			struct HarbolLinkMap bench = harbol_linkmap_create(sizeof(union Value));
+			for( size_t n=0; n<keys; n++ ) {
+				char key[32] = {0};
+				sprintf(key, "bench.key%zu", n);
+				harbol_linkmap_insert(&bench, key, &(union Value){.int64=n});
+			}
+			/* deleting against insertion order skips the newest pair so every delete leaves a hole. */
+			const clock_t start = clock();
+			for( size_t n=0; n + 1<keys; n++ ) {
+				char key[32] = {0};
+				sprintf(key, "bench.key%zu", reverse ? keys - 2 - n : n);
+				const bool deleted = harbol_linkmap_key_del(&bench, key, NULL);
+				assert( deleted );
+			}
+			times[reverse] = (clock() - start) / (double)CLOCKS_PER_SEC;
+			const union Value *const last = harbol_linkmap_index_get(&bench, 0);
+			assert( harbol_linkmap_count(&bench)==1 && last != NULL && last->int64==(int64_t)(keys - 1) );
+			harbol_linkmap_clear(&bench, NULL);
+		}
+		fprintf(g_harbol_debug_stream, "%zu deletes :: in order: %f secs (%f usecs each) | reversed: %f secs (%f usecs each)\n", keys - 1, times[0], times[0] * 1e6 / (keys - 1), times[1], times[1] * 1e6 / (keys - 1));
+	}
+	
 	// free data
 	fputs("\nlinkmap :: test destruction.\n", g_harbol_debug_stream);
 	harbol_linkmap_clear(&i, NULL);
@@ -1510,6 +2837,116 @@ void test_harbol_linkmap(void)
 	fprintf(g_harbol_debug_stream, "p is null? '%s'\n", p ? "no" : "yes");
 }
 
+void test_harbol_frozenmap(void)
+{
+	// test freezing a map.
+	fputs("frozenmap :: test freezing a hashmap.\n", g_harbol_debug_stream);
+	const size_t keys = 100000;
+	struct HarbolMap map = harbol_map_create(sizeof(union Value));
+	for( size_t n=0; n<keys; n++ ) {
+		char key[32] = {0};
+		sprintf(key, "frozen.key%zu", n);
+		harbol_map_insert(&map, key, &(union Value){.int64=n});
+	}
+	clock_t start = clock();
+	struct HarbolFrozenMap fmap = harbol_frozenmap_create_from_map(&map);
+	fprintf(g_harbol_debug_stream, "froze %zu keys in %f secs | block size: %zu bytes\n", harbol_frozenmap_count(&fmap), (clock() - start) / (double)CLOCKS_PER_SEC, fmap.size);
+	assert( fmap.block != NULL && harbol_frozenmap_count(&fmap)==keys );
+	
+	// test retrieval.
+	fputs("\nfrozenmap :: test data retrieval.\n", g_harbol_debug_stream);
+	for( size_t n=0; n<keys; n++ ) {
+		char key[32] = {0};
+		sprintf(key, "frozen.key%zu", n);
+		const union Value *const v = harbol_frozenmap_get(&fmap, key);
+		assert( v != NULL && v->int64==(int64_t)n );
+	}
+	assert( !harbol_frozenmap_has_key(&fmap, "frozen.key") );
+	assert( !harbol_frozenmap_has_key(&fmap, "not a key") );
+	fprintf(g_harbol_debug_stream, "fmap[\"frozen.key42\"] == %" PRIi64 "\n", ((const union Value *)harbol_frozenmap_get(&fmap, "frozen.key42"))->int64);
+	
+	// compare lookup speed against the map it came from.
+	fputs("\nfrozenmap :: benchmarking lookups against the hashmap.\n", g_harbol_debug_stream);
+	{
+		char (*const names)[32] = harbol_alloc(keys, sizeof *names);
+		assert( names );
+		for( size_t n=0; n<keys; n++ )
+			sprintf(names[n], "frozen.key%zu", (n * 7919) % keys);
+		
+		int64_t sum = 0;
+		start = clock();
+		for( size_t r=0; r<4; r++ )
+			for( size_t n=0; n<keys; n++ )
+				sum += ((const union Value *)harbol_map_get(&map, names[n]))->int64;
+		const double map_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		for( size_t r=0; r<4; r++ )
+			for( size_t n=0; n<keys; n++ )
+				sum -= ((const union Value *)harbol_frozenmap_get(&fmap, names[n]))->int64;
+		const double frozen_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		assert( sum==0 );
+		fprintf(g_harbol_debug_stream, "%zu lookups :: hashmap: %f secs | frozenmap: %f secs\n", keys * 4, map_time, frozen_time);
+		harbol_free(names);
+	}
+	
+	// test saving the block to disk & loading it back.
+	fputs("\nfrozenmap :: test writing & reading the block.\n", g_harbol_debug_stream);
+	const bool written = harbol_frozenmap_write_file(&fmap, "frozen_map.bin");
+	assert( written );
+	struct HarbolFrozenMap loaded = harbol_frozenmap_read_file("frozen_map.bin");
+	{
+		// a mapped file can be borrowed in place of reading it into memory.
+		struct HarbolFileView view = harbol_fileview_create("frozen_map.bin");
+		struct HarbolFrozenMap mapped = EMPTY_HARBOL_FROZENMAP;
+		assert( view.data != NULL );
+		const bool mapped_ok = harbol_frozenmap_create_from_block(&mapped, view.data, view.len);
+		assert( mapped_ok && !mapped.owned );
+		fprintf(g_harbol_debug_stream, "frozen map file mmapped? '%s'\n", harbol_fileview_is_mapped(&view) ? "yes" : "no");
+		assert( ((const union Value *)harbol_frozenmap_get(&mapped, "frozen.key42"))->int64==42 );
+		harbol_frozenmap_clear(&mapped);
+		harbol_fileview_clear(&view);
+	}
+	remove("frozen_map.bin");
+	assert( loaded.block != NULL && loaded.size==fmap.size );
+	for( size_t n=0; n<keys; n += 7 ) {
+		char key[32] = {0};
+		sprintf(key, "frozen.key%zu", n);
+		assert( ((const union Value *)harbol_frozenmap_get(&loaded, key))->int64==(int64_t)n );
+	}
+	
+	// a borrowed block doesn't get freed, a corrupt one doesn't get accepted.
+	struct HarbolFrozenMap borrowed = EMPTY_HARBOL_FROZENMAP;
+	const bool borrowed_ok = harbol_frozenmap_create_from_block(&borrowed, loaded.block, loaded.size);
+	assert( borrowed_ok && !borrowed.owned );
+	assert( harbol_frozenmap_has_key(&borrowed, "frozen.key99999") );
+	const bool corrupt_ok = harbol_frozenmap_create_from_block(&borrowed, loaded.block, loaded.size - 8);
+	assert( !corrupt_ok );
+	harbol_frozenmap_clear(&borrowed);
+	harbol_frozenmap_clear(&loaded);
+	harbol_frozenmap_clear(&fmap);
+	harbol_map_clear(&map, NULL);
+	
+	// test freezing a linkmap & an empty map.
+	fputs("\nfrozenmap :: test freezing a linkmap.\n", g_harbol_debug_stream);
+	struct HarbolLinkMap linkmap = harbol_linkmap_create(sizeof(union Value));
+	harbol_linkmap_insert(&linkmap, "a", &(union Value){.int64=1});
+	harbol_linkmap_insert(&linkmap, "b", &(union Value){.int64=2});
+	harbol_linkmap_insert(&linkmap, "c", &(union Value){.int64=3});
+	harbol_linkmap_key_del(&linkmap, "a", NULL);
+	fmap = harbol_frozenmap_create_from_linkmap(&linkmap);
+	assert( harbol_frozenmap_count(&fmap)==2 && !harbol_frozenmap_has_key(&fmap, "a") );
+	fprintf(g_harbol_debug_stream, "fmap[\"b\"] == %" PRIi64 " | fmap[\"c\"] == %" PRIi64 "\n", ((const union Value *)harbol_frozenmap_get(&fmap, "b"))->int64, ((const union Value *)harbol_frozenmap_get(&fmap, "c"))->int64);
+	harbol_frozenmap_clear(&fmap);
+	harbol_linkmap_clear(&linkmap, NULL);
+	
+	struct HarbolMap empty = harbol_map_create(sizeof(union Value));
+	fmap = harbol_frozenmap_create_from_map(&empty);
+	assert( fmap.block != NULL && harbol_frozenmap_get(&fmap, "a")==NULL );
+	harbol_frozenmap_clear(&fmap);
+	fprintf(g_harbol_debug_stream, "fmap's block is null? '%s'\n", fmap.block ? "no" : "yes");
+}
+
 void test_harbol_cfg(void)
 {
 	if( !g_harbol_debug_stream )
@@ -1523,7 +2960,7 @@ void test_harbol_cfg(void)
 	if( cfg ) {
 		fputs("\ncfg :: testing config to string conversion.\n", g_harbol_debug_stream);
 		struct HarbolString stringcfg = harbol_cfg_to_str(cfg);
-		fprintf(g_harbol_debug_stream, "\ncfg :: \n%s\n", stringcfg.cstr);
+		fprintf(g_harbol_debug_stream, "\ncfg :: \n%s\n", harbol_string_cstr(&stringcfg));
 		harbol_string_clear(&stringcfg);
 	}
 	
@@ -1593,18 +3030,18 @@ void test_harbol_cfg(void)
 	if( larger_cfg ) {
 		fputs("\ncfg :: iterating realistic config.\n", g_harbol_debug_stream);
 		struct HarbolString stringcfg = harbol_cfg_to_str(larger_cfg);
-		fprintf(g_harbol_debug_stream, "\ncfg :: test config to string conversion:\n%s\n", stringcfg.cstr);
+		fprintf(g_harbol_debug_stream, "\ncfg :: test config to string conversion:\n%s\n", harbol_string_cstr(&stringcfg));
 		harbol_string_clear(&stringcfg);
 		
 		fputs("\ncfg :: test retrieving sub section of realistic config.\n", g_harbol_debug_stream);
 		struct HarbolLinkMap *phone_numbers1 = harbol_cfg_get_section(larger_cfg, "root.phoneNumbers/..1");
 		stringcfg = harbol_cfg_to_str(phone_numbers1);
-		fprintf(g_harbol_debug_stream, "\nphone_numbers to string conversion: \n%s\n", stringcfg.cstr);
+		fprintf(g_harbol_debug_stream, "\nphone_numbers to string conversion: \n%s\n", harbol_string_cstr(&stringcfg));
 		harbol_string_clear(&stringcfg);
 		if( phone_numbers1 ) {
 			fputs("\ncfg :: iterating phone_numbers1 subsection.\n", g_harbol_debug_stream);
 			struct HarbolString stringcfg = harbol_cfg_to_str(phone_numbers1);
-			fprintf(g_harbol_debug_stream, "\nphone_numbers1 to string conversion: \n%s\n", stringcfg.cstr);
+			fprintf(g_harbol_debug_stream, "\nphone_numbers1 to string conversion: \n%s\n", harbol_string_cstr(&stringcfg));
 			harbol_string_clear(&stringcfg);
 		}
 		
@@ -1634,7 +3071,7 @@ void test_harbol_cfg(void)
 		harbol_cfg_set_cstr(larger_cfg, "root.spouse", "Jane Smith", true);
 		{
 			struct HarbolString stringcfg = harbol_cfg_to_str(larger_cfg);
-			fprintf(g_harbol_debug_stream, "\nadded spouse!: \n%s\n", stringcfg.cstr);
+			fprintf(g_harbol_debug_stream, "\nadded spouse!: \n%s\n", harbol_string_cstr(&stringcfg));
 			harbol_string_clear(&stringcfg);
 		}
 		
@@ -1645,7 +3082,7 @@ void test_harbol_cfg(void)
 		harbol_cfg_set_to_null(larger_cfg, "root.spouse");
 		{
 			struct HarbolString stringcfg = harbol_cfg_to_str(larger_cfg);
-			fprintf(g_harbol_debug_stream, "\nremoved spouse!: \n%s\n", stringcfg.cstr);
+			fprintf(g_harbol_debug_stream, "\nremoved spouse!: \n%s\n", harbol_string_cstr(&stringcfg));
 			harbol_string_clear(&stringcfg);
 		}
 		
@@ -1660,7 +3097,7 @@ void test_harbol_cfg(void)
 			struct HarbolVariant var = harbol_variant_create(&cfg, sizeof(struct HarbolLinkMap *), HarbolCfgType_Linkmap);
 			harbol_linkmap_insert(larger_cfg, "former lovers", &var);
 			struct HarbolString stringcfg = harbol_cfg_to_str(larger_cfg);
-			fprintf(g_harbol_debug_stream, "\nremoved spouse!: \n%s\n", stringcfg.cstr);
+			fprintf(g_harbol_debug_stream, "\nremoved spouse!: \n%s\n", harbol_string_cstr(&stringcfg));
 			harbol_string_clear(&stringcfg);
 		}
 		fputs("\ncfg :: test building newer cfg file!\n", g_harbol_debug_stream);
@@ -1668,6 +3105,68 @@ void test_harbol_cfg(void)
 		harbol_cfg_free(&larger_cfg);
 		fprintf(g_harbol_debug_stream, "cfg ptr valid?: '%s'\n", cfg ? "yes" : "no");
 	}
+	
+	// benchmark parsing a large cfg, short keys & values never touch the heap as strings.
+	fputs("\ncfg :: benchmark parsing a large config.\n", g_harbol_debug_stream);
+	{
+		const size_t entries = 50000;
+		struct HarbolString bench_text = harbol_string_create("'bench': {\n");
+		for( size_t n=0; n<entries; n++ )
+			harbol_string_add_format(&bench_text, "\t'key_%zu': 'value_%zu'\n\t'num_%zu': %zu\n", n, n, n, n);
+		harbol_string_add_cstr(&bench_text, "}\n");
+		
+		const clock_t start = clock();
+		struct HarbolLinkMap *bench_cfg = harbol_cfg_parse_cstr(harbol_string_cstr(&bench_text));
+		const clock_t end = clock();
+		assert( bench_cfg != NULL );
+		
+		struct HarbolLinkMap *const section = harbol_cfg_get_section(bench_cfg, "bench");
+		size_t inline_strs = 0, heap_strs = 0;
+		for( uindex_t n=0; n<section->vec.count; n++ ) {
+			struct HarbolKeyVal **const iter = harbol_vector_get(&section->vec, n);
+			const struct HarbolVariant *const var = (const struct HarbolVariant *)(*iter)->data;
+			if( var->tag==HarbolCfgType_String )
+				harbol_string_is_heap(*(struct HarbolString **)var->data) ? heap_strs++ : inline_strs++;
+		}
+		fprintf(g_harbol_debug_stream, "parsing %zu entries took: %f | string values inline: %zu | on heap: %zu | keys & number tokens lexed inline: %zu\n", entries * 2, (end-start)/(double)CLOCKS_PER_SEC, inline_strs, heap_strs, entries * 3);
+		assert( inline_strs==entries && heap_strs==0 );
+		harbol_cfg_free(&bench_cfg);
+		harbol_string_clear(&bench_text);
+	}
+	
+	// benchmark serializing a deeply nested config, every level goes into the same builder.
+	fputs("\ncfg :: benchmark converting a deeply nested config to a string.\n", g_harbol_debug_stream);
+	{
+		const size_t depth = 64, entries = 500;
+		struct HarbolString bench_text = harbol_string_create("");
+		for( size_t d=0; d<depth; d++ ) {
+			for( size_t n=0; n<entries; n++ )
+				harbol_string_add_format(&bench_text, "'key_%zu': 'value_%zu' 'num_%zu': %zu\n", n, n, n, n);
+			harbol_string_add_format(&bench_text, "'level_%zu': {\n", d);
+		}
+		for( size_t d=0; d<depth; d++ )
+			harbol_string_add_cstr(&bench_text, "}\n");
+		
+		struct HarbolLinkMap *bench_cfg = harbol_cfg_parse_cstr(harbol_string_cstr(&bench_text));
+		assert( bench_cfg != NULL );
+		
+		const clock_t start = clock();
+		struct HarbolString stringcfg = harbol_cfg_to_str(bench_cfg);
+		const clock_t end = clock();
+		fprintf(g_harbol_debug_stream, "converting %zu levels of %zu entries took: %f | output len: %zu\n", depth, entries * 2, (end-start)/(double)CLOCKS_PER_SEC, harbol_string_len(&stringcfg));
+		
+		// the output parses back into the same config.
+		struct HarbolLinkMap *reparsed = harbol_cfg_parse_cstr(harbol_string_cstr(&stringcfg));
+		assert( reparsed != NULL );
+		struct HarbolString restringcfg = harbol_cfg_to_str(reparsed);
+		assert( !harbol_string_cmpstr(&stringcfg, &restringcfg) );
+		harbol_string_clear(&restringcfg);
+		harbol_cfg_free(&reparsed);
+		
+		harbol_string_clear(&stringcfg);
+		harbol_cfg_free(&bench_cfg);
+		harbol_string_clear(&bench_text);
+	}
 	cfg = NULL;
 	fputs("\ncfg :: test destruction.\n", g_harbol_debug_stream);
 	harbol_cfg_free(&cfg);
@@ -1681,12 +3180,12 @@ static void on_plugin_load(struct HarbolPluginMod *const mod, struct HarbolPlugi
 	size_t *const restrict plugin_counts = harbol_plugin_mod_userdata(mod);
 	++*plugin_counts;
 	/* no way manager nor the plugin reference would be invalid... */
-	struct HarbolString load_func_name = {NULL,0};
+	struct HarbolString load_func_name = EMPTY_HARBOL_STRING;
 	harbol_string_format(&load_func_name, "%s_load", harbol_plugin_name(plugin));
 	fprintf(g_harbol_debug_stream, "\nplugin mod :: on_plugin_load - plugin name :: '%s'\n", harbol_plugin_name(plugin));
 	
-	fprintf(g_harbol_debug_stream, "on_plugin_load :: getting function '%s'\n", load_func_name.cstr);
-	__Loader *const onload = (__Loader *)(intptr_t)harbol_plugin_sym(plugin, load_func_name.cstr);
+	fprintf(g_harbol_debug_stream, "on_plugin_load :: getting function '%s'\n", harbol_string_cstr(&load_func_name));
+	__Loader *const onload = (__Loader *)(intptr_t)harbol_plugin_sym(plugin, harbol_string_cstr(&load_func_name));
 	fprintf(g_harbol_debug_stream, "on_plugin_load :: function ptr valid? '%s'\n", onload ? "yes" : "no");
 	if( onload )
 		fprintf(g_harbol_debug_stream, "on_plugin_load :: function return value: '%i'\n", (*onload)());
@@ -1702,11 +3201,11 @@ static void on_plugin_unload(struct HarbolPluginMod *const mod, struct HarbolPlu
 	/* no way manager nor the plugin reference would be invalid... */
 	fprintf(g_harbol_debug_stream, "\nplugin mod :: on_plugin_unload - plugin name :: '%s'\n", harbol_plugin_name(plugin));
 	
-	struct HarbolString unload_func_name = {NULL,0};
+	struct HarbolString unload_func_name = EMPTY_HARBOL_STRING;
 	harbol_string_format(&unload_func_name, "%s_unload", harbol_plugin_name(plugin));
 	
-	__Unloader *const onunload = (__Unloader *)(intptr_t)harbol_plugin_sym(plugin, unload_func_name.cstr);
-	fprintf(g_harbol_debug_stream, "on_plugin_unload :: getting function '%s'\n", unload_func_name.cstr);
+	__Unloader *const onunload = (__Unloader *)(intptr_t)harbol_plugin_sym(plugin, harbol_string_cstr(&unload_func_name));
+	fprintf(g_harbol_debug_stream, "on_plugin_unload :: getting function '%s'\n", harbol_string_cstr(&unload_func_name));
 	fprintf(g_harbol_debug_stream, "on_plugin_unload :: function ptr valid? '%s'\n", onunload ? "yes" : "no");
 	if( onunload )
 		(*onunload)();
@@ -1721,7 +3220,7 @@ void test_harbol_plugins(void)
 	fputs("plugin mod :: test init.\n", g_harbol_debug_stream);
 	size_t plugin_counts = 0;
 	struct HarbolPluginMod pm = harbol_plugin_mod_create("test_harbol_plugins/", &plugin_counts, true, on_plugin_load);
-	fprintf(g_harbol_debug_stream, "\nplugin mod :: initialization good?: '%s' | plugins count: %zu\n", pm.plugins.vec.count>0 ? "yes" : "no", plugin_counts);
+	fprintf(g_harbol_debug_stream, "\nplugin mod :: initialization good?: '%s' | plugins count: %zu\n", harbol_linkmap_count(&pm.plugins)>0 ? "yes" : "no", plugin_counts);
 	
 	fputs("\nplugin mod :: test deleting plugin by name.\n", g_harbol_debug_stream);
 	harbol_plugin_mod_name_del_plugin(&pm, "test_plugin", on_plugin_unload);
@@ -1796,7 +3295,7 @@ void test_harbol_lex(void)
 		const char *end = NULL;
 		bool is_float = false;
 		const bool res = lex_c_style_hex(*i, &end, &lexeme, &is_float);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", lexeme.cstr, is_float ? "yes" : "no");
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1822,7 +3321,7 @@ void test_harbol_lex(void)
 		const char *end = NULL;
 		bool is_float = false;
 		const bool res = lex_go_style_hex(*i, &end, &lexeme, &is_float);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", lexeme.cstr, is_float ? "yes" : "no");
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1852,7 +3351,7 @@ void test_harbol_lex(void)
 		const char *end = NULL;
 		bool is_float = false;
 		const bool res = lex_c_style_decimal(*i, &end, &lexeme, &is_float);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", lexeme.cstr, is_float ? "yes" : "no");
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1880,7 +3379,7 @@ void test_harbol_lex(void)
 		const char *end = NULL;
 		bool is_float = false;
 		const bool res = lex_go_style_decimal(*i, &end, &lexeme, &is_float);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", lexeme.cstr, is_float ? "yes" : "no");
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1898,7 +3397,7 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_go_style_str(*i, &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1916,8 +3415,9 @@ void test_harbol_lex(void)
 	for( const char **i=&c_oct[0]; i<1[&c_oct]; i++ ) {
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
-		const bool res = lex_c_style_octal(*i, &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		bool is_float = false;
+		const bool res = lex_c_style_octal(*i, &end, &lexeme, &is_float);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1936,7 +3436,7 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_go_style_octal(*i, &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1955,7 +3455,7 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_c_style_binary(*i, &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -1970,7 +3470,7 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_go_style_binary(*i, &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -2003,7 +3503,7 @@ void test_harbol_lex(void)
 		const char *end = NULL;
 		bool is_float = false;
 		const bool res = lex_c_style_number(*i, &end, &lexeme, &is_float);
-		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", lexeme.cstr, is_float ? "yes" : "no");
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%s' | is float? %s\n", res ? "yes" : "no", harbol_string_cstr(&lexeme), is_float ? "yes" : "no");
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -2012,7 +3512,7 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_single_line_comment("// kektus \\      \n foobar  \\ \n bazbard", &end, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: comment: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: comment: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
 	
@@ -2021,7 +3521,203 @@ void test_harbol_lex(void)
 		struct HarbolString lexeme = harbol_string_create(NULL);
 		const char *end = NULL;
 		const bool res = lex_multi_line_comment("/** kektus \n foobar  \n bazbard */", &end, "*/", sizeof "*/"-1, &lexeme);
-		fprintf(g_harbol_debug_stream, "result: %s :: comment: '%s'\n", res ? "yes" : "no", lexeme.cstr);
+		fprintf(g_harbol_debug_stream, "result: %s :: comment: '%s'\n", res ? "yes" : "no", harbol_string_cstr(&lexeme));
 		harbol_string_clear(&lexeme);
 	}
+	
+	fputs("\nlex tools :: test zero-copy lexing.\n", g_harbol_debug_stream);
+	{
+		const char src[] = "0x1.8p3f 'esc\\'aped' `raw\\n` 0b1012";
+		const char *iter = src, *end = NULL;
+		struct HarbolStrView view = EMPTY_HARBOL_STRVIEW;
+		bool is_float = false;
+		const bool lexed_num = lex_c_style_number_view(iter, &end, &view, &is_float);
+		assert( lexed_num && is_float && !harbol_strview_cmp(view, harbol_strview("0x1.8p3f")) );
+		iter = end + 1;
+		const bool lexed_str = lex_c_style_str_view(iter, &end, &view);
+		assert( lexed_str && view.ptr==iter + 1 && !harbol_strview_cmp(view, harbol_strview("esc\\'aped")) );
+		iter = end + 1;
+		const bool lexed_raw = lex_go_style_str_view(iter, &end, &view);
+		assert( lexed_raw && !harbol_strview_cmp(view, harbol_strview("raw\\n")) );
+		iter = end + 1;
+		is_float = false;
+		const bool res = lex_go_style_number_view(iter, &end, &view, &is_float);
+		fprintf(g_harbol_debug_stream, "result: %s :: lexeme: '%.*s'\n", res ? "yes" : "no", (int)view.len, view.ptr);
+		assert( !res );
+		const bool lexed_unterminated = lex_c_style_str_view("'unterminated", &end, &view);
+		assert( !lexed_unterminated && *end==0 && !harbol_strview_cmp(view, harbol_strview("unterminated")) );
+	}
+}
+
+/* feeds 'data' into a pipe from another thread so streams bigger than the pipe's buffer don't block. */
+struct FileviewPipe {
+	pthread_t writer;
+	const char *data;
+	size_t len;
+	int fd;
+};
+
+static void *fileview_pipe_writer(void *const arg)
+{
+	struct FileviewPipe *const fp = arg;
+	for( size_t done=0; done < fp->len; ) {
+		const ssize_t wrote = write(fp->fd, &fp->data[done], fp->len - done);
+		if( wrote <= 0 )
+			break;
+		done += (size_t)wrote;
+	}
+	close(fp->fd);
+	return NULL;
+}
+
+static FILE *fileview_pipe_open(struct FileviewPipe *const fp, const char data[const], const size_t len)
+{
+	int fds[2];
+	if( pipe(fds) != 0 )
+		return NULL;
+	
+	fp->data = data, fp->len = len, fp->fd = fds[1];
+	if( pthread_create(&fp->writer, NULL, fileview_pipe_writer, fp) != 0 ) {
+		close(fds[0]), close(fds[1]);
+		return NULL;
+	}
+	return fdopen(fds[0], "rb");
+}
+
+static void fileview_pipe_close(struct FileviewPipe *const fp, FILE *const in)
+{
+	fclose(in);
+	pthread_join(fp->writer, NULL);
+}
+
+void test_harbol_fileview(void)
+{
+	if( !g_harbol_debug_stream )
+		return;
+	
+	// test viewing a regular file.
+	fputs("fileview :: test viewing a regular file.\n", g_harbol_debug_stream);
+	const char text[] = "'section': { 'key': 'value' 'num': 42 }\n";
+	{
+		FILE *file = fopen("fileview_test.cfg", "wb");
+		assert( file != NULL );
+		fputs(text, file);
+		fclose(file);
+	}
+	struct HarbolFileView view = harbol_fileview_create("fileview_test.cfg");
+	fprintf(g_harbol_debug_stream, "view len: '%zu' | mmapped? '%s'\n", view.len, harbol_fileview_is_mapped(&view) ? "yes" : "no");
+	assert( view.data != NULL && view.len==sizeof text - 1 && view.data[view.len]==0 && !strcmp(view.data, text) );
+	assert( !harbol_strview_cmp(harbol_fileview_strview(&view), harbol_strview(text)) );
+	harbol_fileview_clear(&view);
+	assert( view.data==NULL && view.len==0 );
+	
+	// the cfg parser reads straight out of the view.
+	struct HarbolLinkMap *cfg = harbol_cfg_parse_file("fileview_test.cfg");
+	assert( cfg != NULL );
+	const intmax_t *const num = harbol_cfg_get_int(cfg, "section.num");
+	assert( num != NULL && *num==42 );
+	harbol_cfg_free(&cfg);
+	remove("fileview_test.cfg");
+	
+	// files that fill their last page exactly have no room for the terminator so they get copied.
+	fputs("\nfileview :: test viewing a page sized file.\n", g_harbol_debug_stream);
+	{
+		const long page = sysconf(_SC_PAGESIZE);
+		FILE *file = fopen("fileview_page.bin", "wb");
+		assert( file != NULL );
+		for( long n=0; n<page * 2; n++ )
+			fputc('a' + (n % 26), file);
+		fclose(file);
+		
+		view = harbol_fileview_create("fileview_page.bin");
+		fprintf(g_harbol_debug_stream, "view len: '%zu' | mmapped? '%s'\n", view.len, harbol_fileview_is_mapped(&view) ? "yes" : "no");
+		assert( view.data != NULL && view.len==(size_t)page * 2 && !harbol_fileview_is_mapped(&view) && view.data[view.len]==0 );
+		assert( view.data[0]=='a' && view.data[view.len - 1]=='a' + ((page * 2 - 1) % 26) );
+		harbol_fileview_clear(&view);
+		remove("fileview_page.bin");
+		
+		// a missing file gives back an empty view.
+		view = harbol_fileview_create("fileview_missing.bin");
+		assert( view.data==NULL );
+	}
+	
+	// test reading from a pipe, which can't be mapped or sized with ftell.
+	fputs("\nfileview :: test reading non-seekable streams.\n", g_harbol_debug_stream);
+	{
+		struct FileviewPipe fp = {0};
+		FILE *in = fileview_pipe_open(&fp, text, sizeof text - 1);
+		assert( in != NULL );
+		view = harbol_fileview_create_from_file(in);
+		fileview_pipe_close(&fp, in);
+		fprintf(g_harbol_debug_stream, "pipe view len: '%zu' | mmapped? '%s'\n", view.len, harbol_fileview_is_mapped(&view) ? "yes" : "no");
+		assert( view.data != NULL && !harbol_fileview_is_mapped(&view) && !strcmp(view.data, text) );
+		harbol_fileview_clear(&view);
+		
+		// streams bigger than a read chunk have to grow the buffer.
+		const size_t big_len = HARBOL_FILEVIEW_READ_CHUNK * 3 + 5;
+		char *const big = harbol_alloc(big_len, sizeof *big);
+		for( size_t n=0; n<big_len; n++ )
+			big[n] = 'a' + (n % 26);
+		in = fileview_pipe_open(&fp, big, big_len);
+		assert( in != NULL );
+		view = harbol_fileview_create_from_file(in);
+		fileview_pipe_close(&fp, in);
+		assert( view.data != NULL && view.len==big_len && view.data[big_len]==0 && !memcmp(view.data, big, big_len) );
+		harbol_fileview_clear(&view);
+		harbol_free(big);
+		
+		// strings & byte buffers fall back to reading pipes in chunks too.
+		in = fileview_pipe_open(&fp, text, sizeof text - 1);
+		assert( in != NULL );
+		struct HarbolString str = harbol_string_create("old contents");
+		const bool str_read = harbol_string_read_file(&str, in);
+		fileview_pipe_close(&fp, in);
+		assert( str_read && !harbol_string_cmpcstr(&str, text) );
+		harbol_string_clear(&str);
+		
+		in = fileview_pipe_open(&fp, text, sizeof text - 1);
+		assert( in != NULL );
+		struct HarbolByteBuf buf = harbol_bytebuffer_create();
+		harbol_bytebuffer_insert_byte(&buf, '!');
+		const bool buf_read = harbol_bytebuffer_insert_from_file(&buf, in);
+		fileview_pipe_close(&fp, in);
+		assert( buf_read && buf.count==sizeof text && !memcmp(&buf.table[1], text, sizeof text - 1) );
+		harbol_bytebuffer_clear(&buf);
+	}
+	
+	// benchmark loading a large file, reading copies every byte while mapping doesn't.
+	fputs("\nfileview :: benchmark loading a large file.\n", g_harbol_debug_stream);
+	{
+		FILE *file = fopen("fileview_large.cfg", "wb");
+		assert( file != NULL );
+		fputs("'bench': {\n", file);
+		for( size_t n=0; n<200000; n++ )
+			fprintf(file, "\t'key_%zu': 'value_%zu'\n", n, n);
+		fputs("}\n", file);
+		fclose(file);
+		
+		clock_t start = clock();
+		file = fopen("fileview_large.cfg", "rb");
+		struct HarbolString str = EMPTY_HARBOL_STRING;
+		const bool str_read = harbol_string_read_file(&str, file);
+		fclose(file);
+		assert( str_read );
+		const size_t read_sum = harbol_string_count(&str, '_');
+		const double read_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		
+		start = clock();
+		view = harbol_fileview_create("fileview_large.cfg");
+		const struct HarbolString borrowed = harbol_string_borrow(view.data, view.len);
+		const size_t view_sum = harbol_string_count(&borrowed, '_');
+		const double view_time = (clock() - start) / (double)CLOCKS_PER_SEC;
+		fprintf(g_harbol_debug_stream, "%zu bytes :: read into a string: %f secs | viewed (mmapped? '%s'): %f secs\n", view.len, read_time, harbol_fileview_is_mapped(&view) ? "yes" : "no", view_time);
+		assert( read_sum==view_sum && view.len==harbol_string_len(&str) );
+		harbol_fileview_clear(&view);
+		harbol_string_clear(&str);
+		
+		cfg = harbol_cfg_parse_file("fileview_large.cfg");
+		assert( cfg != NULL && harbol_cfg_get_section(cfg, "bench")->vec.count==200000 );
+		harbol_cfg_free(&cfg);
+		remove("fileview_large.cfg");
+	}
 }
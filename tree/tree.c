@@ -13,12 +13,18 @@ HARBOL_EXPORT struct HarbolTree *harbol_tree_new(void *const restrict val, const
 }
 
 HARBOL_EXPORT struct HarbolTree harbol_tree_create(void *const restrict val, const size_t datasize)
+{
+	return harbol_tree_create_with(val, datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolTree harbol_tree_create_with(void *const restrict val, const size_t datasize, const struct HarbolAllocator *const alloc)
 {
 	struct HarbolTree tree = EMPTY_HARBOL_TREE;
-	tree.data = harbol_alloc(datasize, sizeof *tree.data);
+	tree.children.alloc = alloc;
+	tree.data = harbol_alloc_with(alloc, datasize, sizeof *tree.data);
 	if( tree.data != NULL ) {
 		memcpy(tree.data, val, datasize);
-		tree.children = harbol_vector_create(sizeof tree, VEC_DEFAULT_SIZE);
+		tree.children = harbol_vector_create_with(sizeof tree, VEC_DEFAULT_SIZE, alloc);
 	}
 	return tree;
 }
@@ -28,7 +34,7 @@ HARBOL_EXPORT bool harbol_tree_clear(struct HarbolTree *const tree, void dtor(vo
 	if( dtor != NULL )
 		dtor((void**)&tree->data);
 	if( tree->data != NULL )
-		harbol_free(tree->data), tree->data=NULL;
+		harbol_free_with(tree->children.alloc, tree->data), tree->data=NULL;
 	
 	for( uindex_t i=tree->children.count - 1; i<tree->children.count; i-- ) {
 		struct HarbolTree *const child = harbol_tree_index_get_child(tree, i);
@@ -59,7 +65,7 @@ HARBOL_EXPORT bool harbol_tree_set(struct HarbolTree *const restrict tree, void
 	if( datasize==0 )
 		return false;
 	else if( tree->data==NULL ) {
-		tree->data = harbol_alloc(datasize, sizeof *tree->data);
+		tree->data = harbol_alloc_with(tree->children.alloc, datasize, sizeof *tree->data);
 		return( tree->data==NULL ) ? false : memcpy(tree->data, val, datasize) != NULL;
 	}
 	else return memcpy(tree->data, val, datasize) != NULL;
@@ -70,7 +76,7 @@ HARBOL_EXPORT bool harbol_tree_insert_child_val(struct HarbolTree *const restric
 	if( datasize==0 )
 		return false;
 	else {
-		struct HarbolTree node = harbol_tree_create(val, datasize);
+		struct HarbolTree node = harbol_tree_create_with(val, datasize, tree->children.alloc);
 		return( node.data==NULL ) ? !harbol_tree_clear(&node, NULL) : harbol_vector_insert(&tree->children, &node);
 	}
 }
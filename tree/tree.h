@@ -10,7 +10,7 @@ extern "C" {
 #include "../vector/vector.h"
 
 struct HarbolTree {
-	struct HarbolVector children;
+	struct HarbolVector children; // the children's allocator is the node's allocator too.
 	uint8_t *data;
 };
 
@@ -18,6 +18,7 @@ struct HarbolTree {
 
 HARBOL_EXPORT struct HarbolTree *harbol_tree_new(void *val, size_t datasize);
 HARBOL_EXPORT struct HarbolTree harbol_tree_create(void *val, size_t datasize);
+HARBOL_EXPORT struct HarbolTree harbol_tree_create_with(void *val, size_t datasize, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_tree_clear(struct HarbolTree *tree, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_tree_free(struct HarbolTree **treeref, void dtor(void**));
 
@@ -7,18 +7,25 @@
 
 HARBOL_EXPORT struct HarbolUniNode *harbol_uninode_new(void *const data, const size_t datasize)
 {
-	struct HarbolUniNode *restrict node = harbol_alloc(1, sizeof *node);
+	return harbol_uninode_new_with(data, datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolUniNode *harbol_uninode_new_with(void *const data, const size_t datasize, const struct HarbolAllocator *const alloc)
+{
+	struct HarbolUniNode *restrict node = harbol_alloc_with(alloc, 1, sizeof *node);
 	if( node != NULL ) {
 		node->next = NULL;
-		node->data = harbol_alloc(datasize, sizeof *node->data);
-		if( node->data==NULL )
+		node->data = harbol_alloc_with(alloc, datasize, sizeof *node->data);
+		if( node->data==NULL ) {
+			harbol_free_with(alloc, node);
 			return NULL;
+		}
 		else memcpy(node->data, data, datasize);
 	}
 	return node;
 }
 
-HARBOL_EXPORT bool harbol_uninode_free(struct HarbolUniNode **const uninoderef, void dtor(void**))
+static NEVER_NULL(2) bool __harbol_uninode_destroy(const struct HarbolAllocator *const alloc, struct HarbolUniNode **const uninoderef, void dtor(void**))
 {
 	if( *uninoderef==NULL )
 		return false;
@@ -26,13 +33,18 @@ HARBOL_EXPORT bool harbol_uninode_free(struct HarbolUniNode **const uninoderef,
 		if( dtor != NULL )
 			dtor((void**)&(*uninoderef)->data);
 		
-		harbol_free((*uninoderef)->data), (*uninoderef)->data=NULL;
-		harbol_uninode_free(&(*uninoderef)->next, dtor);
-		harbol_free(*uninoderef), *uninoderef = NULL;
+		harbol_free_with(alloc, (*uninoderef)->data), (*uninoderef)->data=NULL;
+		__harbol_uninode_destroy(alloc, &(*uninoderef)->next, dtor);
+		harbol_free_with(alloc, *uninoderef), *uninoderef = NULL;
 		return true;
 	}
 }
 
+HARBOL_EXPORT bool harbol_uninode_free(struct HarbolUniNode **const uninoderef, void dtor(void**))
+{
+	return __harbol_uninode_destroy(NULL, uninoderef, dtor);
+}
+
 HARBOL_EXPORT bool harbol_uninode_set(struct HarbolUniNode *const restrict uninode, void *const restrict data, const size_t datasize)
 {
 	if( datasize==0 )
@@ -58,12 +70,17 @@ HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new(const size_t datasize)
 
 HARBOL_EXPORT struct HarbolUniList harbol_unilist_create(const size_t datasize)
 {
-	return (struct HarbolUniList){NULL, NULL, 0, datasize};
+	return harbol_unilist_create_with(datasize, NULL);
+}
+
+HARBOL_EXPORT struct HarbolUniList harbol_unilist_create_with(const size_t datasize, const struct HarbolAllocator *const alloc)
+{
+	return (struct HarbolUniList){NULL, NULL, 0, datasize, alloc};
 }
 
 HARBOL_EXPORT bool harbol_unilist_clear(struct HarbolUniList *const list, void dtor(void**))
 {
-	harbol_uninode_free(&list->head, dtor);
+	__harbol_uninode_destroy(list->alloc, &list->head, dtor);
 	list->tail = NULL;
 	list->len = 0;
 	return true;
@@ -137,13 +154,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_head(struct HarbolUniList *const res
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolUniNode *node = harbol_uninode_new(val, list->datasize);
+		struct HarbolUniNode *node = harbol_uninode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_unilist_add_node_at_head(list, node);
 			if( !result )
-				harbol_uninode_free(&node, NULL);
+				__harbol_uninode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -154,13 +171,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_tail(struct HarbolUniList *const res
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolUniNode *node = harbol_uninode_new(val, list->datasize);
+		struct HarbolUniNode *node = harbol_uninode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_unilist_add_node_at_tail(list, node);
 			if( !result )
-				harbol_uninode_free(&node, NULL);
+				__harbol_uninode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -171,13 +188,13 @@ HARBOL_EXPORT bool harbol_unilist_insert_at_index(struct HarbolUniList *const re
 	if( list->datasize==0 )
 		return false;
 	else {
-		struct HarbolUniNode *node = harbol_uninode_new(val, list->datasize);
+		struct HarbolUniNode *node = harbol_uninode_new_with(val, list->datasize, list->alloc);
 		if( node==NULL )
 			return false;
 		else {
 			const bool result = harbol_unilist_add_node_at_index(list, node, index);
 			if( !result )
-				harbol_uninode_free(&node, NULL);
+				__harbol_uninode_destroy(list->alloc, &node, NULL);
 			return result;
 		}
 	}
@@ -279,8 +296,8 @@ HARBOL_EXPORT bool harbol_unilist_index_del(struct HarbolUniList *const list, co
 		
 		if( dtor != NULL )
 			dtor((void**)&node->data);
-		harbol_free(node->data);
-		harbol_free(node); node=NULL;
+		harbol_free_with(list->alloc, node->data);
+		harbol_free_with(list->alloc, node); node=NULL;
 		
 		list->len--;
 		if( !list->len && list->tail != NULL )
@@ -314,9 +331,9 @@ HARBOL_EXPORT bool harbol_unilist_node_del(struct HarbolUniList *const list, str
 		
 		if( dtor != NULL )
 			dtor((void**)&node->data);
-		harbol_free(node->data);
+		harbol_free_with(list->alloc, node->data);
 		
-		harbol_free(*noderef); *noderef=NULL;
+		harbol_free_with(list->alloc, *noderef); *noderef=NULL;
 		list->len--;
 		return true;
 	}
@@ -14,6 +14,7 @@ struct HarbolUniNode {
 };
 
 HARBOL_EXPORT NO_NULL struct HarbolUniNode *harbol_uninode_new(void *data, size_t datasize);
+HARBOL_EXPORT NEVER_NULL(1) struct HarbolUniNode *harbol_uninode_new_with(void *data, size_t datasize, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_uninode_free(struct HarbolUniNode **uninoderef, void dtor(void**));
 HARBOL_EXPORT NO_NULL bool harbol_uninode_set(struct HarbolUniNode *uninode, void *data, size_t datasize);
 
@@ -21,11 +22,13 @@ HARBOL_EXPORT NO_NULL bool harbol_uninode_set(struct HarbolUniNode *uninode, voi
 struct HarbolUniList {
 	struct HarbolUniNode *head, *tail;
 	size_t len, datasize;
+	const struct HarbolAllocator *alloc; // nodes come from here, so nodes added by hand must too. NULL uses the default allocator.
 };
 
 
 HARBOL_EXPORT struct HarbolUniList *harbol_unilist_new(size_t datasize);
 HARBOL_EXPORT struct HarbolUniList harbol_unilist_create(size_t datasize);
+HARBOL_EXPORT struct HarbolUniList harbol_unilist_create_with(size_t datasize, const struct HarbolAllocator *alloc);
 
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_unilist_clear(struct HarbolUniList *list, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_unilist_free(struct HarbolUniList **listref, void dtor(void**));
@@ -14,8 +14,13 @@ HARBOL_EXPORT struct HarbolVector *harbol_vector_new(const size_t datasize, cons
 
 HARBOL_EXPORT struct HarbolVector harbol_vector_create(const size_t datasize, const size_t default_size)
 {
-	struct HarbolVector vec = {NULL, 0, 0, datasize};
-	harbol_generic_vector_resizer(&vec, default_size < VEC_DEFAULT_SIZE ? VEC_DEFAULT_SIZE : default_size, vec.datasize);
+	return harbol_vector_create_with(datasize, default_size, NULL);
+}
+
+HARBOL_EXPORT struct HarbolVector harbol_vector_create_with(const size_t datasize, const size_t default_size, const struct HarbolAllocator *const alloc)
+{
+	struct HarbolVector vec = {NULL, 0, 0, datasize, alloc};
+	harbol_generic_vector_resizer(&vec, default_size < VEC_DEFAULT_SIZE ? VEC_DEFAULT_SIZE : default_size, vec.datasize, vec.alloc);
 	return vec;
 }
 
@@ -25,7 +30,7 @@ HARBOL_EXPORT bool harbol_vector_clear(struct HarbolVector *const v, void dtor(v
 		for( uindex_t i=0; i<v->len; i++ )
 			dtor((void**)&(uint8_t *){&v->table[i * v->datasize]});
 	
-	harbol_free(v->table), v->table = NULL;
+	harbol_free_with(v->alloc, v->table), v->table = NULL;
 	v->len = v->count = 0;
 	return true;
 }
@@ -62,18 +67,27 @@ HARBOL_EXPORT bool harbol_vector_resize(struct HarbolVector *const v)
 		return false;
 	else {
 		const size_t old_len = v->len;
-		harbol_generic_vector_resizer(v, v->len==0 ? VEC_DEFAULT_SIZE : v->len << 1, v->datasize);
+		harbol_generic_vector_resizer(v, v->len==0 ? VEC_DEFAULT_SIZE : harbol_grow_len(v->len, v->len + 1), v->datasize, v->alloc);
 		return v->len > old_len;
 	}
 }
 
+HARBOL_EXPORT bool harbol_vector_reserve(struct HarbolVector *const v, const size_t len)
+{
+	if( v->datasize==0 )
+		return false;
+	else if( len <= v->len )
+		return true;
+	else return harbol_generic_vector_resizer(v, len, v->datasize, v->alloc);
+}
+
 HARBOL_EXPORT bool harbol_vector_truncate(struct HarbolVector *const v)
 {
 	if( v->datasize==0 || v->len==VEC_DEFAULT_SIZE )
 		return false;
 	else if( v->count < (v->len >> 1) ) {
 		const size_t old_len = v->len;
-		harbol_generic_vector_resizer(v, v->len >> 1, v->datasize);
+		harbol_generic_vector_resizer(v, v->len >> 1, v->datasize, v->alloc);
 		return old_len > v->len;
 	}
 	else return false;
@@ -146,9 +160,9 @@ HARBOL_EXPORT void harbol_vector_add(struct HarbolVector *const vA, const struct
 	if( vB->table==NULL || vB->datasize==0 || vA->datasize != vB->datasize )
 		return;
 	else {
-		if( !vA->table || vA->count + vB->count >= vA->len )
-			while( (vA->count + vB->count) >= vA->len )
-				harbol_vector_resize(vA);
+		const size_t needed = vA->count + vB->count;
+		if( (needed > vA->len || vA->table==NULL) && !harbol_vector_reserve(vA, harbol_grow_len(vA->len, needed)) )
+			return;
 		memcpy(&vA->table[vA->count * vA->datasize], vB->table, vB->count * vB->datasize);
 		vA->count += vB->count;
 	}
@@ -161,9 +175,8 @@ HARBOL_EXPORT void harbol_vector_copy(struct HarbolVector *const vA, const struc
 	else {
 		harbol_vector_clear(vA, NULL);
 		vA->datasize = vB->datasize;
-		if( vB->count >= vA->len )
-			while( vB->count >= vA->len )
-				harbol_vector_resize(vA);
+		if( !harbol_vector_reserve(vA, vB->count + 1) )
+			return;
 		
 		memcpy(vA->table, vB->table, vB->count * vB->datasize);
 		vA->count = vB->count;
@@ -16,13 +16,15 @@ extern "C" {
 struct HarbolVector {
 	uint8_t *table;
 	size_t len, count, datasize;
+	const struct HarbolAllocator *alloc; // NULL uses the default allocator.
 };
 
-#define EMPTY_HARBOL_VECTOR    {NULL,0,0,0}
+#define EMPTY_HARBOL_VECTOR    {NULL,0,0,0,NULL}
 
 
 HARBOL_EXPORT struct HarbolVector *harbol_vector_new(size_t datasize, size_t default_size);
 HARBOL_EXPORT struct HarbolVector harbol_vector_create(size_t datasize, size_t default_size);
+HARBOL_EXPORT struct HarbolVector harbol_vector_create_with(size_t datasize, size_t default_size, const struct HarbolAllocator *alloc);
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_vector_clear(struct HarbolVector *vec, void dtor(void**));
 HARBOL_EXPORT NEVER_NULL(1) bool harbol_vector_free(struct HarbolVector **vecref, void dtor(void**));
 
@@ -31,6 +33,7 @@ HARBOL_EXPORT NO_NULL void *harbol_vector_get_iter_end_len(const struct HarbolVe
 HARBOL_EXPORT NO_NULL void *harbol_vector_get_iter_end_count(const struct HarbolVector *vec);
 
 HARBOL_EXPORT NO_NULL bool harbol_vector_resize(struct HarbolVector *vec);
+HARBOL_EXPORT NO_NULL bool harbol_vector_reserve(struct HarbolVector *vec, size_t len);
 HARBOL_EXPORT NO_NULL bool harbol_vector_truncate(struct HarbolVector *vec);
 HARBOL_EXPORT NO_NULL bool harbol_vector_reverse(struct HarbolVector *vec, void swap_fn(void *i, void *n));
 